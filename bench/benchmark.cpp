@@ -0,0 +1,77 @@
+#define LOG_TAG "Benchmark"
+
+#include "benchmark.h"
+#include "core.h"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
+Benchmark::Benchmark(const std::string &filter)
+    : mFilter(filter), mResults() {}
+
+void Benchmark::run(const std::string &name, size_t sampleCount,
+                    const Case &body, size_t warmupCount,
+                    const Case &prepare) {
+  CHECK(!name.empty());
+  CHECK(sampleCount > 0);
+  CHECK(body);
+
+  if (name.find(mFilter) == std::string::npos) {
+    return;
+  }
+
+  using BenchClock = std::chrono::steady_clock;
+
+  for (size_t i = 0; i < warmupCount; i++) {
+    if (prepare) {
+      prepare();
+    }
+
+    body();
+  }
+
+  std::vector<double> samples;
+  samples.reserve(sampleCount);
+
+  for (size_t i = 0; i < sampleCount; i++) {
+    if (prepare) {
+      prepare();
+    }
+
+    const auto start = BenchClock::now();
+    body();
+    const auto finish = BenchClock::now();
+
+    samples.push_back(
+        std::chrono::duration<double, std::nano>(finish - start).count());
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  const auto sum = std::accumulate(samples.cbegin(), samples.cend(), 0.0);
+
+  mResults.push_back({name, sampleCount, samples.front(),
+                      samples[samples.size() / 2], sum / samples.size(),
+                      samples.back()});
+
+  LOG("%s: median %.0f ns, %zu samples", name.c_str(),
+      mResults.back().mMedian, sampleCount);
+}
+
+void Benchmark::writeJSON(std::ostream &output) const {
+  output << "{\n  \"unit\": \"ns\",\n  \"benchmarks\": [";
+
+  for (size_t i = 0; i < mResults.size(); i++) {
+    const auto &result = mResults[i];
+
+    output << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.mName
+           << "\", \"samples\": " << result.mSampleCount
+           << ", \"min\": " << result.mMin
+           << ", \"median\": " << result.mMedian
+           << ", \"mean\": " << result.mMean << ", \"max\": " << result.mMax
+           << "}";
+  }
+
+  output << "\n  ]\n}\n";
+}
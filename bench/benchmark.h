@@ -0,0 +1,39 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// times named cases and reports nanoseconds per sample as JSON
+class Benchmark : private sf::NonCopyable {
+public:
+  using Case = std::function<void()>;
+
+  // only cases containing filter are run
+  explicit Benchmark(const std::string &filter);
+
+  // prepare runs before every sample and is not timed
+  void run(const std::string &name, size_t sampleCount, const Case &body,
+           size_t warmupCount = 1u, const Case &prepare = Case());
+
+  void writeJSON(std::ostream &output) const;
+
+private:
+  struct Result {
+    std::string mName;
+    size_t mSampleCount;
+    double mMin;
+    double mMedian;
+    double mMean;
+    double mMax;
+  };
+
+  std::string mFilter;
+  std::vector<Result> mResults;
+};
+
+#endif // BENCHMARK_H
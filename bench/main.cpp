@@ -0,0 +1,156 @@
+#define LOG_TAG "BenchMain"
+
+#include "animationManager.h"
+#include "animationParser.h"
+#include "benchmark.h"
+#include "core.h"
+#include "levelParser.h"
+#include "objectType.h"
+#include "physicsScene.h"
+#include "resourceManager.h"
+#include "tileMap.h"
+#include "utils.h"
+#include "world.h"
+
+#include <SFML/System/Time.hpp>
+
+#include <fstream>
+
+namespace {
+const std::string DEFAULT_OUTPUT_FILE = "bench.json";
+
+const sf::Time TICK_DURATION = sf::seconds(1.f / FRAMERATE);
+
+const size_t PARSE_SAMPLE_COUNT = 20u;
+const size_t TICK_SAMPLE_COUNT = 600u;
+const size_t TICK_WARMUP_COUNT = 60u;
+const size_t MANAGER_SAMPLE_COUNT = 1000u;
+
+const size_t BODY_COUNTS[] = {0u, 50u, 200u};
+const size_t BULLET_COUNTS[] = {10u, 100u, 400u};
+
+const OBJECT_TYPE ANIMATED_TYPES[] = {
+    OBJECT_TYPE::PLAYER,        OBJECT_TYPE::RUNNER,
+    OBJECT_TYPE::ARCHER,        OBJECT_TYPE::ALLIED_BULLET,
+    OBJECT_TYPE::ENEMY_BULLET,  OBJECT_TYPE::EXPLODED_BULLET,
+    OBJECT_TYPE::HORIZONTAL_PLATFORM,
+};
+
+std::string levelFilename(size_t level) {
+  return "Level_" + std::to_string(level + 1) + ".tmx";
+}
+
+void benchLevels(Benchmark &benchmark) {
+  for (size_t level = 0; level < ResourceManager::getLevelCount(); level++) {
+    const auto filename = levelFilename(level);
+    const auto path = LEVELS_DIR + filename;
+
+    benchmark.run("LevelParser/" + filename, PARSE_SAMPLE_COUNT,
+                  [&path]() { LevelParser parser{path}; });
+
+    const auto &info = ResourceManager::getLevelParser(level).getTileMapInfo();
+
+    benchmark.run("TileMap::init/" + filename, PARSE_SAMPLE_COUNT,
+                  [&info]() { TileMap tileMap{info}; });
+  }
+}
+
+void benchAnimations(Benchmark &benchmark) {
+  // the parser is a singleton, so its construction is a single cold sample
+  benchmark.run("AnimationParser::createInstance", 1u,
+                []() { AnimationParser::createInstance(); }, 0u);
+
+  for (const auto type : ANIMATED_TYPES) {
+    benchmark.run(
+        std::string("AnimationParser::createManagerFor/") + toString(type),
+        MANAGER_SAMPLE_COUNT,
+        [type]() { AnimationParser::createManagerFor(type); });
+  }
+}
+
+void benchPhysics(Benchmark &benchmark) {
+  for (const auto bodyCount : BODY_COUNTS) {
+    const auto scene = makeUnique<PhysicsScene>(0u, bodyCount, 0u);
+
+    benchmark.run("PhysicalWorld::update/runners=" + std::to_string(bodyCount),
+                  TICK_SAMPLE_COUNT,
+                  [&scene]() { scene->update(TICK_DURATION); },
+                  TICK_WARMUP_COUNT);
+  }
+
+  // bullets explode on the level walls, every hit passes the contact listener
+  for (const auto bulletCount : BULLET_COUNTS) {
+    const auto scene = makeUnique<PhysicsScene>(0u, 0u, bulletCount);
+
+    benchmark.run("CustomContactListener/bullets=" +
+                      std::to_string(bulletCount),
+                  TICK_SAMPLE_COUNT,
+                  [&scene]() { scene->update(TICK_DURATION); },
+                  TICK_WARMUP_COUNT);
+  }
+}
+
+void benchWorld(Benchmark &benchmark) {
+  for (size_t level = 0; level < ResourceManager::getLevelCount(); level++) {
+    std::unique_ptr<World> world;
+
+    // a finished level starts over outside of the measurement
+    const auto prepare = [&world, level]() {
+      if (world == nullptr || world->failed() || world->success()) {
+        world = makeUnique<World>(level);
+      }
+    };
+
+    benchmark.run("World::update/" + levelFilename(level), TICK_SAMPLE_COUNT,
+                  [&world]() { world->update(TICK_DURATION); },
+                  TICK_WARMUP_COUNT, prepare);
+  }
+}
+
+const char *nextArgument(int argc, char **argv, int &index) {
+  CHECK(index + 1 < argc);
+
+  return argv[++index];
+}
+} // unnamed namespace
+
+// Platformer_bench [--output FILE] [--filter SUBSTRING]
+int main(int argc, char **argv) {
+  std::string outputFile = DEFAULT_OUTPUT_FILE;
+  std::string filter;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+
+    if (argument == "--output") {
+      outputFile = nextArgument(argc, argv, i);
+    } else if (argument == "--filter") {
+      filter = nextArgument(argc, argv, i);
+    } else {
+      LOG("unknown argument: %s", argument.c_str());
+      CHECK(false);
+    }
+  }
+
+  ResourceManager::createHeadlessInstance();
+
+  Benchmark benchmark{filter};
+
+  // animations first, the cold parser construction is measured there
+  benchAnimations(benchmark);
+  benchLevels(benchmark);
+  benchPhysics(benchmark);
+  benchWorld(benchmark);
+
+  std::ofstream output(outputFile);
+
+  CHECK(output.is_open());
+
+  benchmark.writeJSON(output);
+
+  CHECK(output.good());
+
+  LOG("results saved to %s", outputFile.c_str());
+
+  return 0;
+}
@@ -0,0 +1,102 @@
+#define LOG_TAG "PhysicsScene"
+
+#include "physicsScene.h"
+#include "animationManager.h"
+#include "bullet.h"
+#include "core.h"
+#include "levelParser.h"
+#include "objectType.h"
+#include "physicalBody.h"
+#include "physicalWorld.h"
+#include "player.h"
+#include "resourceManager.h"
+#include "runner.h"
+#include "utils.h"
+
+const sf::Vector2f PhysicsScene::mBulletSize = {10.f, 10.f};
+
+PhysicsScene::PhysicsScene(size_t level, size_t runnerCount,
+                           size_t bulletCount)
+    : mPhysicalWorld(), mPlayer(), mEntities(), mBulletCount(bulletCount),
+      mActiveBulletCount(0) {
+  const auto &levelParser = ResourceManager::getLevelParser(level);
+
+  // bodies of the level enemies and platforms are dropped
+  PhysicalWorld::PhysicalBodyMap bodyMap;
+  mPhysicalWorld = makeUnique<PhysicalWorld>(levelParser, bodyMap);
+
+  auto &playerBodies = bodyMap[OBJECT_TYPE::PLAYER];
+
+  CHECK(playerBodies.size() == 1u);
+
+  mPlayer = makeUnique<Player>(std::move(playerBodies.back()));
+  mPhysicalWorld->setPlayerCallback(mPlayer.get());
+
+  spawnRunners(level, runnerCount);
+  spawnBullets();
+}
+
+PhysicsScene::~PhysicsScene() {}
+
+void PhysicsScene::update(sf::Time dt) {
+  mPhysicalWorld->update(dt);
+
+  for (const auto &entity : mEntities) {
+    entity->update(dt);
+  }
+
+  mPlayer->update(dt);
+
+  mEntities.remove_if([this](const std::unique_ptr<Entity> &entity) {
+    if (!entity->isDestroyed()) {
+      return false;
+    }
+
+    if (entity->getType() == OBJECT_TYPE::EXPLODED_BULLET) {
+      mActiveBulletCount--;
+    }
+
+    return true;
+  });
+
+  spawnBullets();
+}
+
+void PhysicsScene::spawnRunners(size_t level, size_t runnerCount) {
+  const auto &levelParser = ResourceManager::getLevelParser(level);
+
+  // runners are stacked above the level ones, or above the player
+  const auto sourceType = levelParser.hasType(OBJECT_TYPE::RUNNER)
+                              ? OBJECT_TYPE::RUNNER
+                              : OBJECT_TYPE::PLAYER;
+  const auto &sources = levelParser.getObjectsFor(sourceType);
+
+  for (size_t i = 0; i < runnerCount; i++) {
+    auto bounds = sources[i % sources.size()];
+    bounds.top -= 1.5f * bounds.height * (i / sources.size() + 1);
+
+    auto body = makeUnique<PhysicalBody>(*mPhysicalWorld, bounds,
+                                         OBJECT_TYPE::RUNNER);
+
+    mEntities.push_back(makeUnique<Runner>(std::move(body)));
+  }
+}
+
+void PhysicsScene::spawnBullets() {
+  const auto playerBounds = mPlayer->getBoundingRect();
+  const auto &playerPosition = mPlayer->getPosition();
+
+  for (; mActiveBulletCount < mBulletCount; mActiveBulletCount++) {
+    const auto heading =
+        mActiveBulletCount % 2 == 0 ? HEADING::RIGHT : HEADING::LEFT;
+    const auto offset = heading == HEADING::RIGHT ? playerBounds.width
+                                                  : -playerBounds.width;
+    const sf::FloatRect bounds = {
+        {playerPosition.x + offset, playerPosition.y}, mBulletSize};
+
+    auto body = makeUnique<PhysicalBody>(*mPhysicalWorld, bounds,
+                                         OBJECT_TYPE::ALLIED_BULLET);
+
+    mEntities.push_back(makeUnique<Bullet>(heading, std::move(body)));
+  }
+}
@@ -0,0 +1,41 @@
+#ifndef PHYSICSSCENE_H
+#define PHYSICSSCENE_H
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <list>
+#include <memory>
+
+namespace sf {
+class Time;
+}
+
+class Entity;
+class PhysicalWorld;
+class Player;
+
+// static geometry and player of a level with a configurable amount of
+// runners and bullets, stepped without the rest of World
+class PhysicsScene : private sf::NonCopyable {
+public:
+  explicit PhysicsScene(size_t level, size_t runnerCount, size_t bulletCount);
+  ~PhysicsScene();
+
+  void update(sf::Time dt);
+
+private:
+  static const sf::Vector2f mBulletSize;
+
+  std::unique_ptr<PhysicalWorld> mPhysicalWorld;
+  std::unique_ptr<Player> mPlayer;
+  std::list<std::unique_ptr<Entity>> mEntities;
+
+  size_t mBulletCount;
+  size_t mActiveBulletCount;
+
+  void spawnRunners(size_t level, size_t runnerCount);
+  void spawnBullets();
+};
+
+#endif // PHYSICSSCENE_H
@@ -1,6 +1,8 @@
 #ifndef ANIMATIONMANAGER_H
 #define ANIMATIONMANAGER_H
 
+#include "resourceManager.h"
+
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/System/NonCopyable.hpp>
 
@@ -15,6 +17,7 @@ class Animation;
 namespace sf {
 class Time;
 class Sprite;
+class Texture;
 } // namespace sf
 
 class AnimationManager : public sf::Drawable, private sf::NonCopyable {
@@ -35,6 +38,11 @@ public:
   void changeHeading();
 
   const sf::IntRect &getCurrentFrame() const;
+
+  // current frame mirrored for the left heading, as it is drawn
+  sf::IntRect getTextureRect() const;
+  // empty in headless mode
+  const TextureHandle &getTexture() const;
   sf::Time getDuration() const;
 
   void setLoop(bool loop) const;
@@ -55,6 +63,7 @@ private:
   AnimationMap::const_iterator mCurrentAnimation;
   HEADING mHeading;
 
+  TextureHandle mTexture;
   std::unique_ptr<sf::Sprite> mSprite;
 
   void draw(sf::RenderTarget &target, sf::RenderStates states) const final;
@@ -3,23 +3,30 @@
 
 #include <SFML/System/Clock.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/Window/Keyboard.hpp>
 
 #include <memory>
+#include <string>
 
 namespace sf {
 class RenderWindow;
 }
 
 class StateManager;
+struct LaunchOptions;
 
 class Application : private sf::NonCopyable {
 public:
-  Application();
+  explicit Application(const LaunchOptions &options);
+  ~Application();
 
   void run();
 
 private:
   static const sf::Time mFrameDuration;
+  static const sf::Time mMinRenderDuration;
+  static const size_t mMaxTicksPerFrame;
+  static const sf::Keyboard::Key mProfilerToggleKey;
 
   sf::RenderWindow *mWindow;
   std::unique_ptr<StateManager> mStateManager;
@@ -27,10 +34,13 @@ private:
   sf::Clock mClock;
   sf::Time mTimeSincePrevFrame;
 
+  std::string mProfileFile;
+
 private:
   void handleEvents();
+  void toggleProfiler();
   void update(sf::Time dt);
-  void render() const;
+  void render(float interpolation) const;
 };
 
 #endif // APPLICATION_H
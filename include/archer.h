@@ -5,6 +5,8 @@
 
 #include <SFML/System/Time.hpp>
 
+#include <vector>
+
 class PhysicalBody;
 
 class Archer : public Shooter {
@@ -27,12 +29,23 @@ private:
   static const sf::Vector2f mBulletLeftOffset;
   static const float mHiddenHeight;
 
+  // the player is looked for in this area around the archer
+  static const sf::Vector2f mSightHalfSize;
+
   std::unique_ptr<PhysicalBody> mPhysBody;
   sf::Time mShootingCountdown;
 
+  // kept to not allocate on every look around
+  std::vector<sf::Vector2f> mPlayerPositions;
+
+  // an archer shoots only at a player in range and not behind a wall
+  bool findVisiblePlayer(sf::Vector2f &playerPosition);
+
   void spawnBullet();
 
   void onDraw(sf::RenderStates &states) const final;
+
+  b2Body *getBody() const final;
 };
 
 #endif // ARCHER_H
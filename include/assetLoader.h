@@ -0,0 +1,52 @@
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class BackgroundThread;
+class WorkerPool;
+
+// parses the first level and the entity descriptions and decodes fonts,
+// sounds and the images of the intro, the menu and the first level on a
+// worker pool while the main thread keeps drawing; the decoded images are
+// uploaded by update, on the thread of the window
+class AssetLoader : private sf::NonCopyable {
+public:
+  AssetLoader();
+  ~AssetLoader();
+
+  // main thread only, uploads one texture once decoding is done
+  void update();
+
+  bool isDone() const;
+
+  // in [0, 1], decoding and uploading take a half each
+  float getProgress() const;
+
+private:
+  using Task = std::function<void()>;
+
+  std::vector<Task> mTasks;
+  std::atomic<size_t> mFinishedTaskCount;
+  std::atomic<bool> mDecoded;
+
+  // known once decoding is done
+  std::vector<std::string> mUploads;
+  size_t mUploadedCount;
+  bool mUploadsListed;
+
+  std::unique_ptr<WorkerPool> mWorkerPool;
+  // runs the blocking parallel loop, so that the main thread is free
+  std::unique_ptr<BackgroundThread> mThread;
+
+  void addTasks();
+  void decode();
+};
+
+#endif // ASSETLOADER_H
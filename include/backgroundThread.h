@@ -0,0 +1,39 @@
+#ifndef BACKGROUNDTHREAD_H
+#define BACKGROUNDTHREAD_H
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// single long-lived thread running one job at a time
+class BackgroundThread : private sf::NonCopyable {
+public:
+  using Job = std::function<void()>;
+
+  BackgroundThread();
+  ~BackgroundThread();
+
+  // the previous job must be waited for
+  void run(const Job &job);
+
+  // returns at once if there is no job
+  void wait();
+
+private:
+  std::mutex mMutex;
+  std::condition_variable mJobReady;
+  std::condition_variable mJobDone;
+
+  Job mJob;
+  bool mBusy;
+  bool mStopping;
+
+  std::thread mThread;
+
+  void threadLoop();
+};
+
+#endif // BACKGROUNDTHREAD_H
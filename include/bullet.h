@@ -11,12 +11,19 @@ class PhysicalBody;
 class Bullet : public Entity {
 public:
   explicit Bullet(HEADING heading, std::unique_ptr<PhysicalBody> body);
+  ~Bullet() final;
+
+  // used by BulletPool
+  void reset(HEADING heading, const sf::Vector2f &position);
+  void deactivate();
 
   void update(sf::Time dt) final;
 
   bool isDestroyed() const final;
 
   OBJECT_TYPE getType() const final;
+  // type of the shot, kept after the explosion
+  OBJECT_TYPE getBulletType() const;
 
 private:
   static const int mBulletHitpoints;
@@ -25,9 +32,14 @@ private:
   OBJECT_TYPE mType;
   std::unique_ptr<PhysicalBody> mPhysBody;
 
+  // explosion while flying, flight after the explosion
+  std::unique_ptr<AnimationManager> mSpareAnimationManager;
+
   sf::Time mExplodeCountdown;
 
   ANIMATION_TYPE objToAnimationType(OBJECT_TYPE type) const;
+
+  b2Body *getBody() const final;
 };
 
 #endif // BULLET_H
@@ -0,0 +1,47 @@
+#ifndef BULLETPOOL_H
+#define BULLETPOOL_H
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+enum class HEADING;
+enum class OBJECT_TYPE;
+class Bullet;
+class PhysicalWorld;
+
+// keeps exploded bullets with their deactivated bodies for the next shots
+class BulletPool : private sf::NonCopyable {
+public:
+  // capacity limits the amount of idle bullets of each type
+  explicit BulletPool(PhysicalWorld &physicalWorld, size_t prewarmCount,
+                      size_t capacity);
+  ~BulletPool();
+
+  std::unique_ptr<Bullet> acquire(OBJECT_TYPE type, HEADING heading,
+                                  const sf::Vector2f &position);
+  void release(std::unique_ptr<Bullet> bullet);
+
+  size_t getHitCount() const;
+  size_t getMissCount() const;
+  size_t getIdleCount() const;
+
+private:
+  static const sf::Vector2f mBulletSize;
+
+  PhysicalWorld &mPhysicalWorld;
+  size_t mCapacity;
+
+  std::map<OBJECT_TYPE, std::vector<std::unique_ptr<Bullet>>> mIdleBullets;
+
+  size_t mHitCount;
+  size_t mMissCount;
+
+  std::unique_ptr<Bullet> create(OBJECT_TYPE type, HEADING heading,
+                                 const sf::Vector2f &position) const;
+};
+
+#endif // BULLETPOOL_H
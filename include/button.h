@@ -43,6 +43,8 @@ public:
 
   sf::FloatRect getBoundingRect() const;
 
+  static const std::string mTextureName;
+
 private:
   enum class BUTTON_TYPE {
     REGULAR,
@@ -52,7 +54,6 @@ private:
   };
 
   static const std::map<BUTTON_TYPE, sf::IntRect> mBoundsMap;
-  static const std::string mTextureName;
   static const std::string mActivationSound;
 
   BUTTON_TYPE mType;
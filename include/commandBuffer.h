@@ -0,0 +1,49 @@
+#ifndef COMMANDBUFFER_H
+#define COMMANDBUFFER_H
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <vector>
+
+enum class HEADING;
+enum class OBJECT_TYPE;
+
+// side effects of entity updates that run in parallel; World applies the
+// buffers in chunk order afterwards, which keeps the serial entity order
+class CommandBuffer : private sf::NonCopyable {
+public:
+  enum class COMMAND_TYPE { SPAWN_BULLET };
+
+  struct Command {
+    COMMAND_TYPE mType;
+    HEADING mHeading;
+    OBJECT_TYPE mObjectType;
+    sf::Vector2f mPosition;
+  };
+
+  // makes the buffer current for the calling thread until destruction
+  class Binding : private sf::NonCopyable {
+  public:
+    explicit Binding(CommandBuffer &buffer);
+    ~Binding();
+
+  private:
+    CommandBuffer *mPrevious;
+  };
+
+  CommandBuffer();
+
+  static CommandBuffer &getCurrent();
+
+  void spawnBullet(HEADING heading, OBJECT_TYPE type,
+                   const sf::Vector2f &position);
+
+  const std::vector<Command> &getCommands() const;
+  void clear();
+
+private:
+  std::vector<Command> mCommands;
+};
+
+#endif // COMMANDBUFFER_H
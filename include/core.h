@@ -29,6 +29,7 @@ const std::string APPLICATION_NAME = "Platformer";
 // directories
 const std::string MEDIA_DIR = "Media/";
 const std::string ENTITIES_DIR = MEDIA_DIR + "Entities/";
+const std::string ATLAS_ENTITIES_DIR = ENTITIES_DIR + "Atlas/";
 const std::string TEXTURES_DIR = MEDIA_DIR + "Textures/";
 const std::string FONTS_DIR = MEDIA_DIR + "Fonts/";
 const std::string LEVELS_DIR = MEDIA_DIR + "Levels/";
@@ -40,6 +41,7 @@ const unsigned int WINDOW_WIDTH = 640u;
 const unsigned int WINDOW_HEIGHT = 480u;
 
 const unsigned int FRAMERATE = 60u;
+const unsigned int MAX_RENDER_FRAMERATE = 240u;
 
 const float GRAVITY = -10.f;
 
@@ -1,10 +1,12 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
+#include "resourceManager.h"
 #include "userData.h"
 
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/NonCopyable.hpp>
 
 #include <memory>
 
@@ -15,7 +17,8 @@ class AnimationManager;
 
 namespace sf {
 class Time;
-}
+class Texture;
+} // namespace sf
 
 class Entity : public sf::Drawable,
                public sf::Transformable,
@@ -55,9 +58,28 @@ public:
   HEADING getHeading() const;
   void changeHeading();
 
+  // rendering blends the positions of the last two ticks
+  void savePreviousPosition();
+  sf::Vector2f getInterpolationOffset(float interpolation) const;
+
+  // what draw would render, without the interpolation offset
+  sf::Transform getRenderTransform() const;
+  const TextureHandle &getTexture() const;
+  sf::IntRect getTextureRect() const;
+
+  // an entity far from the player is frozen, its body leaves the simulation
+  // and keeps its velocity until the entity is simulated again
+  void setSimulated(bool simulated);
+  bool isSimulated() const;
+
 protected:
   void initAnimationManager(OBJECT_TYPE objectType,
                             ANIMATION_TYPE animationType, HEADING heading);
+  // exchanges the current manager with a prebuilt one
+  void swapAnimationManager(std::unique_ptr<AnimationManager> &manager);
+
+  // restores the hitpoints of a killed entity that is reused
+  void revive();
 
   AnimationManager &getAnimationManager() const;
 
@@ -66,10 +88,16 @@ protected:
 
   virtual void onDraw(sf::RenderStates &states) const;
 
+  // null for entities without physics
+  virtual b2Body *getBody() const;
+
 private:
   int mMaxHitpoints;
   int mHitpoints;
   sf::Vector2f mVelocity;
+  sf::Vector2f mPreviousPosition;
+  bool mHasPreviousPosition;
+  bool mSimulated;
   UserData mUserData;
 
   std::unique_ptr<AnimationManager> mAnimationManager;
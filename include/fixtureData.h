@@ -0,0 +1,19 @@
+#ifndef FIXTUREDATA_H
+#define FIXTUREDATA_H
+
+#include "userData.h"
+
+#include <Box2D/Common/b2Math.h>
+
+class b2Fixture;
+
+// slot owned by PhysicalWorld, every fixture user data points to one
+struct FixtureData {
+  UserData mUserData;
+  b2Vec2 mSizeInPixels;
+
+  // solid part of a ladder, null for other fixtures
+  b2Fixture *mLinkedFixture;
+};
+
+#endif // FIXTUREDATA_H
@@ -1,6 +1,7 @@
 #ifndef GAMEOVERSTATE_H
 #define GAMEOVERSTATE_H
 
+#include "resourceManager.h"
 #include "stateBase.h"
 
 #include <SFML/Graphics/Color.hpp>
@@ -39,6 +40,7 @@ private:
 
   std::unique_ptr<Label> mHeaderLabel;
   std::unique_ptr<ButtonView> mButtonView;
+  TextureHandle mTexture;
   std::unique_ptr<sf::Sprite> mSprite;
 
   std::unique_ptr<AnimatedEntity> mAnimatedEntity;
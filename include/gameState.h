@@ -3,10 +3,16 @@
 
 #include "stateBase.h"
 
+#include <SFML/Window/Keyboard.hpp>
+
 #include <memory>
 
 class World;
 
+namespace sf {
+class Sprite;
+}
+
 class GameState : public StateBase {
 public:
   explicit GameState(StateManager &stateManager);
@@ -14,11 +20,15 @@ public:
 
   void handleEvent(const sf::Event &event) final;
   void update(sf::Time dt) final;
+  void setInterpolation(float interpolation) final;
+
+  const World *getWorld() const final;
 
 private:
-  std::unique_ptr<World> mWorld;
+  static const sf::Keyboard::Key mDebugDrawToggleKey;
 
-  void setDefaultView() const;
+  std::unique_ptr<World> mWorld;
+  std::unique_ptr<sf::Sprite> mSceneSprite;
 
   void draw(sf::RenderTarget &target, sf::RenderStates states) const final;
 };
@@ -0,0 +1,54 @@
+#ifndef GEOMETRYBAKER_H
+#define GEOMETRYBAKER_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <set>
+#include <utility>
+#include <vector>
+
+struct TileMapInfo;
+
+// merges touching static shapes into closed outlines for b2ChainShape;
+// shapes are laid on the tile grid, edges shared by two shapes cancel out
+class GeometryBaker : private sf::NonCopyable {
+public:
+  // in pixels, clockwise on the screen
+  using Outline = std::vector<sf::Vector2f>;
+
+  explicit GeometryBaker(unsigned int gridSize);
+
+  // false if the shape is off the grid or overlaps an added one,
+  // such a shape should keep its own body
+  bool addRectangle(const sf::FloatRect &rect);
+  bool addSlope(const sf::FloatRect &rect, bool isSlopeLeft);
+
+  // every non-empty tile is a solid cell
+  void addTiles(const TileMapInfo &info);
+
+  size_t getShapeCount() const;
+
+  std::vector<Outline> bake() const;
+
+private:
+  using Point = std::pair<int, int>;
+  using Edge = std::pair<Point, Point>;
+
+  const float mGridSize;
+
+  std::set<Point> mCells;
+  std::set<Edge> mEdges;
+  size_t mShapeCount;
+
+  bool toGrid(const sf::FloatRect &rect, sf::IntRect &gridRect) const;
+
+  bool occupy(const sf::IntRect &gridRect);
+
+  // axis-aligned edges are split into cell-long pieces to meet their twins
+  void addEdge(const Point &from, const Point &to);
+  void addPiece(const Point &from, const Point &to);
+};
+
+#endif // GEOMETRYBAKER_H
@@ -0,0 +1,32 @@
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include "launchOptions.h"
+
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <string>
+
+class World;
+
+// steps World as fast as possible, without window and audio device;
+// the levels and input may come from a recording
+class HeadlessRunner : private sf::NonCopyable {
+public:
+  explicit HeadlessRunner(const LaunchOptions &options);
+
+  void run();
+
+private:
+  static const sf::Time mTickDuration;
+
+  LaunchOptions mOptions;
+
+  void runLevel(size_t level) const;
+  void runLevelFile() const;
+  void simulate(World &world, const std::string &title) const;
+  bool levelFinished(const World &world, size_t tickCount) const;
+};
+
+#endif // HEADLESSRUNNER_H
@@ -4,9 +4,12 @@
 #include <SFML/System/NonCopyable.hpp>
 #include <SFML/Window/Keyboard.hpp>
 
+#include <cstdint>
 #include <map>
 #include <memory>
 
+class InputRecord;
+
 enum class KEY_TYPE {
   RIGHT,
   LEFT,
@@ -26,12 +29,31 @@ public:
   static void setKey(KEY_TYPE type, sf::Keyboard::Key key);
   static sf::Keyboard::Key getKey(KEY_TYPE type);
 
+  // state latched by the last tick
   static bool isKeyPressed(KEY_TYPE type);
 
+  // recording is saved by stopRecording, replay substitutes the keyboard
+  static void startRecording(const std::string &filename);
+  static void stopRecording();
+  static void startReplay(const std::string &filename);
+
+  static bool isReplaying();
+  static size_t getReplayLevelCount();
+  static size_t getReplayLevel(size_t index);
+  static bool isReplayLevelFinished();
+
+  // used only by World
+  static void beginLevel(size_t level);
+  static void tick();
+
   static const LayoutMap &getLayout(bool isDefault);
   static void saveLayout();
 
 private:
+  enum class SOURCE { KEYBOARD, REPLAY };
+
+  using KeyMask = std::uint8_t;
+
   static std::unique_ptr<InputManager> mInstance;
 
   static const LayoutMap mDefaultLayoutMap;
@@ -47,10 +69,24 @@ private:
 
   LayoutMap mLayoutMap;
 
+  SOURCE mSource;
+  KeyMask mKeyMask;
+
+  std::unique_ptr<InputRecord> mRecord;
+  std::string mRecordFile;
+
+  size_t mReplaySegment;
+  size_t mReplayTick;
+
   static InputManager &getInstance();
 
   InputManager();
 
+  KeyMask pollKeyboard() const;
+  KeyMask nextReplayTick();
+
+  static KeyMask toMask(KEY_TYPE type);
+
   void parseLayout();
 
   static KEY_TYPE keyTitleToType(const std::string &title);
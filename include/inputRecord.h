@@ -0,0 +1,42 @@
+#ifndef INPUTRECORD_H
+#define INPUTRECORD_H
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// key states of every tick, grouped by played level;
+// stored on disk run-length encoded
+class InputRecord : private sf::NonCopyable {
+public:
+  using KeyMask = std::uint8_t;
+  using TickVector = std::vector<KeyMask>;
+
+  InputRecord();
+
+  void beginLevel(size_t level);
+  void push(KeyMask mask);
+
+  size_t getSegmentCount() const;
+  size_t getLevel(size_t segment) const;
+  const TickVector &getTicks(size_t segment) const;
+
+  void save(const std::string &filename) const;
+  void load(const std::string &filename);
+
+private:
+  static const std::string mMagic;
+  static const std::uint8_t mVersion;
+  static const size_t mMaxRunLength;
+
+  struct Segment {
+    size_t mLevel;
+    TickVector mTicks;
+  };
+
+  std::vector<Segment> mSegments;
+};
+
+#endif // INPUTRECORD_H
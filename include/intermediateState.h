@@ -37,7 +37,6 @@ private:
   sf::Time mInfoCountdown;
   bool mShowInfo;
 
-  std::unique_ptr<sf::Texture> mBackgroundTexture;
   std::unique_ptr<sf::Sprite> mBackgroundSprite;
   std::unique_ptr<sf::RectangleShape> mBackgroundRectangle;
 
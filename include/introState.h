@@ -23,6 +23,8 @@ public:
   void handleEvent(const sf::Event &event) final;
   void update(sf::Time dt) final;
 
+  static const std::string mRollingTextureName;
+
 private:
   static const ComponentDefinition mHeaderDefinition;
 
@@ -31,7 +33,6 @@ private:
 
   static const sf::Vector2f mEntityInitPosition;
   static const sf::Vector2f mEntityScale;
-  static const std::string mRollingTextureName;
   static const std::string mRavenSound;
 
   std::unique_ptr<Label> mHeaderLabel;
@@ -0,0 +1,41 @@
+#ifndef LAUNCHOPTIONS_H
+#define LAUNCHOPTIONS_H
+
+#include <cstddef>
+#include <string>
+
+struct LaunchOptions {
+  // run World without window, audio and keyboard
+  bool mHeadless;
+
+  // 1-based level number, 0 means every level
+  size_t mLevel;
+
+  // headless mode runs this TMX file instead of the shipped levels
+  std::string mLevelFile;
+
+  // headless mode stops a level after this amount of ticks
+  size_t mTickCount;
+
+  // per-tick keyboard state is saved to this file on exit
+  std::string mRecordFile;
+
+  // headless mode plays the levels of this recording instead
+  std::string mReplayFile;
+
+  // profile from the start; the capture is saved to mProfileFile
+  bool mProfile;
+  std::string mProfileFile;
+
+  // the world tick runs on a background thread while a frame is drawn
+  bool mPipelined;
+
+  // megabytes of decoded textures kept resident, 0 keeps the default
+  size_t mMemoryBudget;
+
+  LaunchOptions();
+};
+
+LaunchOptions parseLaunchOptions(int argc, const char *const *argv);
+
+#endif // LAUNCHOPTIONS_H
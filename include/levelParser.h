@@ -11,16 +11,29 @@
 #include <vector>
 
 enum class OBJECT_TYPE;
+class TiXmlElement;
+
+struct TileLayerInfo {
+  std::vector<unsigned int> mGids;
+
+  // share of the view movement the layer follows, {1, 1} for the level one
+  sf::Vector2f mParallax;
+
+  // layers with positive depth are drawn over the entities
+  int mDepth;
+};
 
 struct TileMapInfo {
   std::string mTilesetTextureName;
   sf::Vector2u mMapRectNum;
-  std::vector<unsigned int> mGids;
+
+  // in file order; the first one is the collision layer
+  std::vector<TileLayerInfo> mLayers;
   unsigned int mFirstgid;
   unsigned int mTileSize;
 
   void set(const std::string &pathToTexture, const sf::Vector2u &mapRectNum,
-           const std::vector<unsigned int> &gids, unsigned int firstgid,
+           const std::vector<TileLayerInfo> &layers, unsigned int firstgid,
            unsigned int tileSize);
 };
 
@@ -28,6 +41,7 @@ class LevelParser : private sf::NonCopyable {
 public:
   using ObjectArray = std::vector<sf::FloatRect>;
 
+  // path is relative to the working directory
   explicit LevelParser(const std::string &filename);
 
   const TileMapInfo &getTileMapInfo() const;
@@ -39,6 +53,10 @@ public:
 
   bool isRequiredType(OBJECT_TYPE type) const;
 
+  // set by the map property collision="tiles": every non-empty tile is solid
+  // and solid objects are not needed
+  bool hasTileCollision() const;
+
 private:
   struct NameTypePair {
     std::string name;
@@ -48,14 +66,27 @@ private:
   static const std::set<OBJECT_TYPE> mRequiredObjectTypes;
   static const NameTypePair mNameTypeMap[];
   static const size_t mNameTypeMapSize;
+  static const std::string mTileCollisionValue;
 
   TileMapInfo mInfo;
+  bool mTileCollision;
   std::map<OBJECT_TYPE, ObjectArray> mObjectMap;
 
   void parseFile(const std::string &filename);
 
+  TileLayerInfo parseLayer(const TiXmlElement *const layerElem,
+                           const sf::Vector2u &mapRectNum) const;
+
+  void parseObjectGroup(const TiXmlElement *const objectgroupElem);
+
   std::vector<unsigned int> parseGids(const char *const gidStr) const;
 
+  bool parseTileCollision(const TiXmlElement *const mapElem) const;
+
+  // the <property> child of the element's <properties> with the name
+  const TiXmlElement *findProperty(const TiXmlElement *const elem,
+                                   const std::string &name) const;
+
   OBJECT_TYPE nameToType(const std::string &name) const;
 };
 
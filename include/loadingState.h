@@ -0,0 +1,41 @@
+#ifndef LOADINGSTATE_H
+#define LOADINGSTATE_H
+
+#include "stateBase.h"
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <memory>
+
+class AssetLoader;
+
+namespace sf {
+class RectangleShape;
+}
+
+// first state, draws a progress bar without any asset while the rest is
+// loaded and moves on to the intro once everything is resident
+class LoadingState : public StateBase {
+public:
+  explicit LoadingState(StateManager &stateManager);
+  ~LoadingState() final;
+
+  void handleEvent(const sf::Event &event) final;
+  void update(sf::Time dt) final;
+
+private:
+  static const sf::Vector2f mBarSize;
+  static const sf::Color mBarColor;
+  static const sf::Color mFrameColor;
+  static const float mFrameThickness;
+
+  std::unique_ptr<AssetLoader> mLoader;
+
+  std::unique_ptr<sf::RectangleShape> mFrame;
+  std::unique_ptr<sf::RectangleShape> mBar;
+
+  void draw(sf::RenderTarget &target, sf::RenderStates states) const final;
+};
+
+#endif // LOADINGSTATE_H
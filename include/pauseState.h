@@ -33,7 +33,6 @@ private:
   std::unique_ptr<Label> mHeaderLabel;
   std::unique_ptr<ButtonView> mButtonView;
 
-  std::unique_ptr<sf::Texture> mBackgroundTexture;
   std::unique_ptr<sf::Sprite> mBackgroundSprite;
   std::unique_ptr<sf::RectangleShape> mBackgroundRectangle;
 
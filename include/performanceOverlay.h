@@ -0,0 +1,59 @@
+#ifndef PERFORMANCEOVERLAY_H
+#define PERFORMANCEOVERLAY_H
+
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Time.hpp>
+
+#include <deque>
+#include <memory>
+
+namespace sf {
+class Text;
+}
+
+class World;
+
+// frame time graph and simulation counters drawn over the current state
+class PerformanceOverlay : public sf::Drawable, private sf::NonCopyable {
+public:
+  PerformanceOverlay();
+  ~PerformanceOverlay() final;
+
+  void toggle();
+  bool isVisible() const;
+
+  // world is null outside of the game
+  void addFrame(sf::Time frameTime, sf::Time tickTime, sf::Time renderTime,
+                const World *world);
+
+private:
+  struct FrameTimes {
+    sf::Time mFrame;
+    sf::Time mTick;
+    sf::Time mRender;
+  };
+
+  static const size_t mHistorySize;
+  static const size_t mTextRefreshFrames;
+  static const float mPixelsPerMillisecond;
+  static const float mMaxGraphMilliseconds;
+  static const sf::Vector2f mPosition;
+  static const std::string mFontName;
+  static const unsigned int mCharacterSize;
+
+  bool mVisible;
+  std::deque<FrameTimes> mHistory;
+  size_t mFramesSinceRefresh;
+
+  sf::VertexArray mGraph;
+  std::unique_ptr<sf::Text> mText;
+
+  void updateGraph();
+  void updateText(const World *world);
+
+  void draw(sf::RenderTarget &target, sf::RenderStates states) const final;
+};
+
+#endif // PERFORMANCEOVERLAY_H
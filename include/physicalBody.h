@@ -20,6 +20,9 @@ public:
   OBJECT_TYPE getType() const;
   b2Body &getBody() const;
 
+  // lets entities query their surroundings
+  const PhysicalWorld &getPhysicalWorld() const;
+
 private:
   PhysicalWorld &mPhysicalWorld;
   sf::FloatRect mBounds;
@@ -5,18 +5,22 @@
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/NonCopyable.hpp>
 
-#include <list>
+#include <cstdint>
+#include <deque>
 #include <map>
 #include <memory>
+#include <vector>
 
 struct PhysicalBody;
 enum class OBJECT_TYPE;
 class LevelParser;
+class GeometryBaker;
 class b2Body;
 class b2Vec2;
 struct PlayerCallback;
 class b2World;
 class UserData;
+struct FixtureData;
 class b2Fixture;
 
 namespace sf {
@@ -29,6 +33,16 @@ public:
   using PhysicalBodyVector = std::vector<std::unique_ptr<PhysicalBody>>;
   using PhysicalBodyMap = std::map<const OBJECT_TYPE, PhysicalBodyVector>;
 
+  // bit per OBJECT_TYPE, selects the fixtures seen by the spatial queries
+  using TypeMask = uint32_t;
+
+  struct RayHit {
+    OBJECT_TYPE mType;
+
+    // in pixels
+    sf::Vector2f mPoint;
+  };
+
   explicit PhysicalWorld(const LevelParser &levelParser,
                          PhysicalBodyMap &bodyMap);
   ~PhysicalWorld() final;
@@ -46,9 +60,27 @@ public:
 
   bool finished() const;
 
+  size_t getBodyCount() const;
+  size_t getContactCount() const;
+  size_t getProxyCount() const;
+
+  static TypeMask getTypeMask(OBJECT_TYPE type);
+
+  // the queries only read the broadphase, so entities updated in parallel
+  // may run them between two steps; coordinates are in pixels
+
+  // appends the position of the body of every fixture of the masked types
+  // whose bounding box overlaps the area
+  void queryArea(const sf::FloatRect &area, TypeMask mask,
+                 std::vector<sf::Vector2f> &positions) const;
+
+  // the closest fixture of the masked types on the segment, others are
+  // passed through
+  bool castRay(const sf::Vector2f &from, const sf::Vector2f &to, TypeMask mask,
+               RayHit &hit) const;
+
 private:
   class CustomContactListener;
-  class CustomContactFilter;
 
   static const int mVelocityIterations;
   static const int mPositionIterations;
@@ -56,37 +88,52 @@ private:
   static const float mSolidOnLadderHeight;
 
   std::unique_ptr<CustomContactListener> mContactListener;
-  std::unique_ptr<CustomContactFilter> mContactFilter;
   std::unique_ptr<b2World> mWorld;
 
-  // user data for non-entity bodies
-  std::list<std::unique_ptr<UserData>> mNonEntityUserDataArray;
-
-  std::map<const b2Fixture *, const b2Vec2> mFixtureSizeMap;
-
-  std::map<const b2Fixture *, b2Fixture *> mLadderSolidMap;
+  // slab behind the user data of every fixture, deque keeps slots in place;
+  // released slots are reused before the slab grows
+  std::deque<FixtureData> mFixtureData;
+  std::vector<FixtureData *> mFreeFixtureData;
 
   sf::Vector2f mPlayerSensorOffset;
   PlayerCallback *mPlayerCallback;
 
-  mutable sf::VertexArray mVertices;
+  // static bodies never move, their outlines are built once;
+  // the rest is rebuilt on every draw
+  sf::VertexArray mStaticVertices;
+  mutable sf::VertexArray mDynamicVertices;
 
   void initEntityBodies(const LevelParser &parser, PhysicalBodyMap &bodyMap);
 
   void initNonEntityBodies(const LevelParser &parser);
 
-  b2Body *createBody(const sf::FloatRect &bounds, UserData *const userData);
+  // one static body with a chain fixture per baked outline
+  void createStaticGeometry(const GeometryBaker &baker);
+
+  FixtureData *allocateFixtureData(OBJECT_TYPE type,
+                                   const b2Vec2 &sizeInPixels);
+  void releaseFixtureData(FixtureData *const fixtureData);
+
+  void bakeStaticDrawing();
 
   void draw(sf::RenderTarget &target, sf::RenderStates states) const final;
 
-  void addRectangleToDrawing(const b2Vec2 &pos, const b2Vec2 &size,
-                             const sf::Color &color) const;
+  void addBodyToDrawing(sf::VertexArray &drawing,
+                        const b2Body *const body) const;
+
+  void addRectangleToDrawing(sf::VertexArray &drawing, const b2Vec2 &pos,
+                             const b2Vec2 &size, const sf::Color &color) const;
+
+  void addTriangleToDrawing(sf::VertexArray &drawing, const b2Vec2 &pos,
+                            const b2Vec2 &size, const sf::Color &color,
+                            bool isSlopeLeft) const;
 
-  void addTriangleToDrawing(const b2Vec2 &pos, const b2Vec2 &size,
-                            const sf::Color &color, bool isSlopeLeft) const;
+  void addChainToDrawing(sf::VertexArray &drawing,
+                         const b2Fixture *const fixture,
+                         const sf::Color &color) const;
 
   template <size_t size>
-  void createBoundaryAtPosition(const b2Vec2 &pos,
+  void createBoundaryAtPosition(sf::VertexArray &drawing, const b2Vec2 &pos,
                                 const b2Vec2 (&vertices)[size],
                                 const sf::Color &color) const {
     sf::Vertex vertexArray[size];
@@ -95,14 +142,14 @@ private:
       vertexArray[i] = {shiftVertexAtPosition(vertices[i], pos), color};
     }
 
-    mVertices.append(vertexArray[0]);
+    drawing.append(vertexArray[0]);
 
     for (size_t i = 1; i < size; ++i) {
-      mVertices.append(vertexArray[i]);
-      mVertices.append(vertexArray[i]);
+      drawing.append(vertexArray[i]);
+      drawing.append(vertexArray[i]);
     }
 
-    mVertices.append(vertexArray[0]);
+    drawing.append(vertexArray[0]);
   }
 
   sf::Vector2f shiftVertexAtPosition(const b2Vec2 &point,
@@ -26,6 +26,8 @@ private:
 
   std::unique_ptr<PhysicalBody> mPhysBody;
   sf::Time mTimeSinceLastTurn;
+
+  b2Body *getBody() const final;
 };
 
 #endif // PLATFORM_H
@@ -96,6 +96,8 @@ private:
   bool isLoopedAnimation(ANIMATION_TYPE type) const;
 
   void onDraw(sf::RenderStates &states) const final;
+
+  b2Body *getBody() const final;
 };
 
 #endif // PLAYER_H
@@ -0,0 +1,63 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define PROFILE_CONCAT_IMPL(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+
+// name must be a string literal, it is stored by pointer
+#define PROFILE_SCOPE(name)                                                    \
+  const Profiler::Zone PROFILE_CONCAT(profileZone, __LINE__) { name }
+
+// nested timing zones, recorded into a fixed ring buffer per thread
+// and exported as Chrome trace JSON or CSV
+class Profiler : private sf::NonCopyable {
+public:
+  class Zone : private sf::NonCopyable {
+  public:
+    explicit Zone(const char *name);
+    ~Zone();
+
+  private:
+    const char *mName;
+    std::int64_t mStart;
+  };
+
+  static void createInstance();
+
+  static void setEnabled(bool enabled);
+  static bool isEnabled();
+
+  // .csv extension selects CSV, any other one Chrome trace JSON
+  static void dump(const std::string &filename);
+
+private:
+  struct Event;
+  class ThreadBuffer;
+
+  static std::unique_ptr<Profiler> mInstance;
+  static std::atomic<bool> mEnabled;
+
+  static const size_t mEventsPerThread;
+
+  mutable std::mutex mBufferMutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> mBuffers;
+
+  static Profiler &getInstance();
+  static ThreadBuffer &getThreadBuffer();
+
+  Profiler();
+
+  void dumpTrace(std::ostream &output) const;
+  void dumpCSV(std::ostream &output) const;
+};
+
+#endif // PROFILER_H
@@ -2,54 +2,100 @@
 #define RESOURCEMANAGER_H
 
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
 
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace sf {
 class RenderWindow;
 class Texture;
 class Font;
+class Image;
 class SoundBuffer;
 } // namespace sf
 
 class LevelParser;
 
+// keeps a texture resident, it may be evicted after the last one is gone
+using TextureHandle = std::shared_ptr<const sf::Texture>;
+
+// files are loaded on first use; resources returned by reference stay
+// resident until exit, the ones behind handles count against the memory
+// budget and the least recently used unreferenced ones are evicted
 class ResourceManager : private sf::NonCopyable {
 public:
   static void createInstance();
 
+  // no window, fonts, sounds and textures; texture handles are empty
+  static void createHeadlessInstance();
+  static bool isHeadless();
+
   static sf::RenderWindow &getWindow();
   static const sf::Texture &getTexture(const std::string &filename);
+  static TextureHandle acquireTexture(const std::string &filename);
+  static sf::Vector2u getTextureSize(const std::string &filename);
   static const sf::Font &getFont(const std::string &filename);
   static const sf::SoundBuffer &getSoundBuffer(const std::string filename);
 
+  // decoding runs on any thread, the upload needs the thread of the window;
+  // a decoded texture waits for it under the memory budget
+  static void decodeTexture(const std::string &filename);
+  static std::vector<std::string> getDecodedTextures();
+  static void uploadTexture(const std::string &filename);
+
+  static std::vector<std::string> getFontNames();
+  static std::vector<std::string> getSoundNames();
+
   static size_t getLevelCount();
+  // parsed on first use, safe to call from several threads
   static const LevelParser &getLevelParser(size_t level);
-  static const sf::Texture &getLevelTexture(size_t level);
+  static TextureHandle getLevelTexture(size_t level);
+
+  // textures a level keeps resident while it is played
+  static std::vector<std::string> getLevelManifest(size_t level);
+
+  // in decoded bytes; textures past the budget are evicted on the next load,
+  // least recently used first, unless they are pinned or still referenced
+  static void setMemoryBudget(size_t budget);
+  static size_t getResidentMemory();
 
 private:
   template <typename ResourceType> class ResourceHolder;
 
   using TextureHolder = ResourceHolder<sf::Texture>;
+  using ImageHolder = ResourceHolder<sf::Image>;
   using FontHolder = ResourceHolder<sf::Font>;
   using SoundHolder = ResourceHolder<sf::SoundBuffer>;
 
   static std::unique_ptr<const ResourceManager> mInstance;
+  static bool mHeadless;
 
   static const std::string mLevelTextures[];
+  static const size_t mDefaultMemoryBudget;
 
   std::unique_ptr<sf::RenderWindow> mWindow;
 
-  std::unique_ptr<const TextureHolder> mTextureHolder;
-  std::unique_ptr<const FontHolder> mFontHolder;
-  std::unique_ptr<const SoundHolder> mSoundHolder;
+  std::unique_ptr<TextureHolder> mTextureHolder;
+  // decoded textures waiting for the upload; the headless replacement of
+  // mTextureHolder, keeps texture sizes available
+  std::unique_ptr<ImageHolder> mImageHolder;
+  std::unique_ptr<FontHolder> mFontHolder;
+  std::unique_ptr<SoundHolder> mSoundHolder;
 
-  std::map<const size_t, std::unique_ptr<const LevelParser>> mLevelParserMap;
+  std::map<const size_t, std::string> mLevelFileMap;
+  mutable std::mutex mLevelMutex;
+  mutable std::map<const size_t, std::unique_ptr<const LevelParser>>
+      mLevelParserMap;
 
   static const ResourceManager &getInstance();
 
   ResourceManager();
+
+  void uploadDecodedTexture(const std::string &filename) const;
 };
 
 #endif // RESOURCEMANAGER_H
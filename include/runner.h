@@ -24,8 +24,17 @@ private:
 
   static const sf::Time mTurnDelay;
 
+  // a wall closer than this to the front of the runner turns it around
+  static const float mWallDistance;
+
   std::unique_ptr<PhysicalBody> mPhysBody;
   sf::Time mTimeSinceLastTurn;
+
+  void turn();
+
+  bool isWallAhead() const;
+
+  b2Body *getBody() const final;
 };
 
 #endif // RUNNER_H
@@ -6,6 +6,7 @@
 
 #include <list>
 #include <memory>
+#include <mutex>
 
 namespace sf {
 class Sound;
@@ -20,6 +21,8 @@ public:
 
   static void removeStopped();
 
+  static size_t getVoiceCount();
+
   static void setListenerPosition(const sf::Vector2f &position);
   static const sf::Vector2f getListenerPosition();
 
@@ -31,6 +34,8 @@ private:
   static const float mMinDistance2D;
   static const float mMinDistance3D;
 
+  // World may be updated on another thread than the one drawing
+  std::mutex mSoundMutex;
   std::list<sf::Sound> mSounds;
 
   static SoundPlayer &getInstance();
@@ -0,0 +1,51 @@
+#ifndef SPRITEBATCH_H
+#define SPRITEBATCH_H
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/NonCopyable.hpp>
+
+#include <vector>
+
+namespace sf {
+class RenderTarget;
+class Texture;
+class Transform;
+} // namespace sf
+
+// collects textured quads and draws every run of quads sharing a layer and
+// a texture with one call; lower layers are drawn first
+class SpriteBatch : private sf::NonCopyable {
+public:
+  SpriteBatch();
+
+  void clear();
+
+  // the quad of an sf::Sprite with this rect, a negative width or height
+  // flips the texture
+  void add(const sf::Texture &texture, const sf::IntRect &textureRect,
+           const sf::Transform &transform, size_t layer);
+
+  void render(sf::RenderTarget &target, sf::RenderStates states);
+
+  // calls issued by the last render
+  size_t getDrawCallCount() const;
+
+private:
+  static const size_t mQuadVertexCount;
+
+  struct Quad {
+    size_t mLayer;
+    const sf::Texture *mTexture;
+    size_t mFirstVertex;
+  };
+
+  std::vector<Quad> mQuads;
+  std::vector<sf::Vertex> mVertices;
+  std::vector<sf::Vertex> mSortedVertices;
+
+  size_t mDrawCallCount;
+};
+
+#endif // SPRITEBATCH_H
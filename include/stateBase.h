@@ -5,6 +5,7 @@
 #include <SFML/System/NonCopyable.hpp>
 
 class StateManager;
+class World;
 
 namespace sf {
 class Event;
@@ -18,6 +19,12 @@ public:
   virtual void handleEvent(const sf::Event &event) = 0;
   virtual void update(sf::Time dt);
 
+  // fraction of the tick elapsed since the last update
+  virtual void setInterpolation(float interpolation);
+
+  // simulated world of the state, if any
+  virtual const World *getWorld() const;
+
 protected:
   StateManager &getStateManager() const;
 
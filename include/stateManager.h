@@ -3,17 +3,22 @@
 
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/System/NonCopyable.hpp>
+#include <SFML/Window/Keyboard.hpp>
 
 #include <functional>
 #include <memory>
 
 namespace sf {
 class Event;
+class RenderTexture;
+class Texture;
 class Time;
 } // namespace sf
 
 enum class STATE_TYPE;
+class PerformanceOverlay;
 class StateBase;
+class World;
 
 class StateManager : public sf::Drawable, private sf::NonCopyable {
 public:
@@ -22,6 +27,10 @@ public:
 
   void handleEvent(const sf::Event &event);
   void update(sf::Time dt);
+  void setInterpolation(float interpolation);
+
+  // statistics of the last presented frame, shown by the overlay
+  void addFrame(sf::Time frameTime, sf::Time tickTime, sf::Time renderTime);
 
   STATE_TYPE getCurrentStateType() const;
 
@@ -32,8 +41,18 @@ public:
   // used only by GameState
   void increaseLevel();
 
+  // worlds created from now on tick on a background thread
+  void setPipelined(bool pipelined);
+  bool isPipelined() const;
+
+  // offscreen target of the world; overlay states draw its texture, which
+  // keeps the last world frame after GameState is paused or gone
+  sf::RenderTexture &getScene() const;
+  const sf::Texture &getSceneTexture() const;
+
 private:
   static const STATE_TYPE mInitialStateType;
+  static const sf::Keyboard::Key mOverlayToggleKey;
 
   std::unique_ptr<StateBase> mState;
   std::unique_ptr<StateBase> mCachedState;
@@ -42,8 +61,13 @@ private:
   STATE_TYPE mDestinationStateType;
 
   size_t mCurrentLevel;
+  bool mPipelined;
+
+  std::unique_ptr<PerformanceOverlay> mOverlay;
+  std::unique_ptr<sf::RenderTexture> mScene;
 
   bool hasState() const;
+  const World *getWorld() const;
 
   bool hasStateTransition() const;
   void handleStateTransition();
@@ -2,6 +2,7 @@
 #define STATETYPE_H
 
 enum class STATE_TYPE {
+  LOADING,
   INTRO,
   MENU,
   SETTINGS,
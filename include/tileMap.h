@@ -1,34 +1,66 @@
 #ifndef TILEMAP_H
 #define TILEMAP_H
 
+#include "resourceManager.h"
+
+#include <SFML/Graphics/RenderStates.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/System/NonCopyable.hpp>
 
 #include <memory>
+#include <vector>
 
 namespace sf {
 class RenderTarget;
 }
 
-class TileMapInfo;
+struct TileLayerInfo;
+struct TileMapInfo;
 
-class TileMap : public sf::Drawable, private sf::NonCopyable {
+// tiles are split into square chunks that keep only non-empty tiles;
+// layers sharing depth and parallax are merged into one batch, and only
+// the chunks of a batch overlapping the view of the target are submitted
+class TileMap : private sf::NonCopyable {
 public:
   explicit TileMap(const TileMapInfo &info);
 
   const sf::Vector2u &getMapSize() const;
   unsigned int getTileSize() const;
 
+  // layers of depth 0 and below, under the entities
+  void drawBackLayers(sf::RenderTarget &target, sf::RenderStates states) const;
+  // layers of positive depth, over the entities
+  void drawFrontLayers(sf::RenderTarget &target, sf::RenderStates states) const;
+
 private:
-  const sf::Texture &mTexture;
-  sf::VertexArray mVertices;
+  // side of a chunk in tiles
+  static const unsigned int mChunkTileCount;
+
+  struct Batch {
+    int mDepth;
+    sf::Vector2f mParallax;
+
+    // row by row, mChunkCount.x chunks per row
+    std::vector<sf::VertexArray> mChunks;
+  };
+
+  const TextureHandle mTexture;
+
+  // ordered by depth, then by the first layer of the batch in the file
+  std::vector<Batch> mBatches;
+  sf::Vector2u mChunkCount;
 
   sf::Vector2u mMapSize;
   unsigned int mTileSize;
 
   void init(const TileMapInfo &info);
 
-  void draw(sf::RenderTarget &target, sf::RenderStates states) const final;
+  Batch &getBatchFor(const TileLayerInfo &layer);
+  void addLayer(Batch &batch, const TileLayerInfo &layer,
+                const TileMapInfo &info);
+
+  void drawBatch(const Batch &batch, sf::RenderTarget &target,
+                 sf::RenderStates states) const;
 };
 
 #endif // TILEMAP_H
@@ -1,12 +1,11 @@
 #ifndef USERDATA_H
 #define USERDATA_H
 
-#include <SFML/System/NonCopyable.hpp>
-
 enum class OBJECT_TYPE;
 class Entity;
 
-class UserData : private sf::NonCopyable {
+// small value, copied into the fixture slots of PhysicalWorld
+class UserData {
 public:
   explicit UserData(OBJECT_TYPE type);
   explicit UserData(Entity *const entity);
@@ -19,7 +18,7 @@ public:
   Entity *getEntity() const;
 
 private:
-  const bool mExtended;
+  bool mExtended;
 
   union {
     OBJECT_TYPE mType;
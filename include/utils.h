@@ -22,6 +22,7 @@ const unsigned int STATE_CHAR_SIZE = 50u;
 const std::string STATE_TEXTURE_NAME = "Space.png";
 
 class UserData;
+struct FixtureData;
 class b2Fixture;
 class b2Vec2;
 enum class OBJECT_TYPE;
@@ -49,7 +50,10 @@ std::shared_ptr<Type> makeShared(Args &&...args) {
   return instance;
 }
 
+FixtureData *getFixtureData(const b2Fixture *const fixture);
 UserData *getFixtureUserData(const b2Fixture *const fixture);
+void setFixtureUserData(const b2Fixture *const fixture,
+                        const UserData &userData);
 
 unsigned int strToUintSave(const std::string &str, size_t *const pos = nullptr,
                            int base = 10);
@@ -74,6 +78,12 @@ template <typename Type> inline Type toPixels(const Type &meters) {
   return {toPixels(meters.x), toPixels(meters.y)};
 }
 
+// linear blend between two states, alpha in [0, 1]
+template <typename Type>
+inline Type interpolate(const Type &from, const Type &to, float alpha) {
+  return from + (to - from) * alpha;
+}
+
 template <typename Type> inline Type toB2Coords(const Type &pixels) {
   return toMeters(Type{pixels.x, -pixels.y});
 }
@@ -0,0 +1,55 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <SFML/System/NonCopyable.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// fixed set of threads running the chunks of a parallel loop; the calling
+// thread takes part as well and parallelFor returns when every chunk is done
+class WorkerPool : private sf::NonCopyable {
+public:
+  // chunk is in [0, getChunkCount()), [begin, end) is its part of the range
+  using ChunkFunction =
+      std::function<void(size_t chunk, size_t begin, size_t end)>;
+
+  explicit WorkerPool(size_t threadCount);
+  ~WorkerPool();
+
+  // a range is always split into this many contiguous chunks,
+  // so that the same index lands in the same chunk on every run
+  size_t getChunkCount() const;
+
+  void parallelFor(size_t count, const ChunkFunction &function);
+
+  // hardware threads minus the calling one
+  static size_t getDefaultThreadCount();
+
+private:
+  const size_t mChunkCount;
+
+  std::vector<std::thread> mThreads;
+
+  std::mutex mMutex;
+  std::condition_variable mWorkReady;
+  std::condition_variable mWorkDone;
+
+  // published to the workers by the reset of mNextChunk
+  const ChunkFunction *mFunction;
+  size_t mCount;
+
+  std::atomic<size_t> mNextChunk;
+  size_t mFinishedChunks;
+  size_t mGeneration;
+  bool mStopping;
+
+  void workerLoop();
+  void runChunks();
+};
+
+#endif // WORKERPOOL_H
@@ -1,6 +1,8 @@
 #ifndef WORLD_H
 #define WORLD_H
 
+#include "resourceManager.h"
+
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/View.hpp>
 #include <SFML/System/NonCopyable.hpp>
@@ -14,47 +16,116 @@ namespace sf {
 class Event;
 class Time;
 class Sprite;
+class Texture;
 } // namespace sf
 
 enum class HEADING;
 enum class OBJECT_TYPE;
+class BackgroundThread;
+class Bullet;
+class BulletPool;
+class CommandBuffer;
+class LevelParser;
 class PhysicalWorld;
 class Player;
 class Entity;
 class TileMap;
 class PhysicalBody;
+class WorkerPool;
+class WorldSnapshot;
 
 class World : public sf::Drawable, private sf::NonCopyable {
 public:
   explicit World(size_t currentLevel);
+  // level that is not one of the shipped ones, input is not recorded
+  explicit World(const LevelParser &levelParser,
+                 const TextureHandle &background);
   ~World() final;
 
+  // in pipelined mode the tick runs on a background thread and update
+  // returns at once; draw, failed and success use the previous tick
   void update(sf::Time dt);
 
+  void setPipelined(bool pipelined);
+
+  // outlines of the physical bodies over the level; while shown, draw
+  // waits for a pipelined tick
+  void toggleDebugDraw();
+
+  // fraction of the tick elapsed since the last update, used by draw
+  void setInterpolation(float interpolation);
+
   bool failed() const;
   bool success() const;
 
+  // entities farther than margin pixels from the view are not simulated
+  void setSimulationMargin(float margin);
+
+  // these wait for a tick in progress
+  size_t getEntityCount() const;
+  size_t getSimulatedEntityCount() const;
+
+  // sprites of the last frame within the view, read without waiting
+  size_t getDrawnEntityCount() const;
+  const PhysicalWorld &getPhysicalWorld() const;
+  const BulletPool &getBulletPool() const;
+
 private:
-  static const sf::Vector2f mBulletSize;
+  static const size_t mBulletPoolPrewarmCount;
+  static const size_t mBulletPoolCapacity;
+  static const float mDefaultSimulationMargin;
+  static const size_t mParallelUpdateThreshold;
 
   std::unique_ptr<PhysicalWorld> mPhysicalWorld;
+  std::unique_ptr<BulletPool> mBulletPool;
 
   std::unique_ptr<Player> mPlayer;
   std::list<std::unique_ptr<Entity>> mEntities;
+  std::list<std::unique_ptr<Bullet>> mBullets;
+
+  // entity updates run in chunks, one command buffer per chunk
+  std::unique_ptr<WorkerPool> mWorkerPool;
+  std::vector<std::unique_ptr<CommandBuffer>> mCommandBuffers;
+  std::vector<Entity *> mSimulatedEntities;
 
   sf::View mView;
+  sf::Vector2f mPreviousViewCenter;
+  float mInterpolation;
+  float mSimulationMargin;
   std::unique_ptr<const TileMap> mTileMap;
+
+  // the textures of the level manifest are kept resident while it is played
+  std::vector<TextureHandle> mResidentTextures;
   std::unique_ptr<sf::Sprite> mBackground;
 
+  // the front snapshot is drawn, the back one is written by the tick
+  std::unique_ptr<WorldSnapshot> mFrontSnapshot;
+  std::unique_ptr<WorldSnapshot> mBackSnapshot;
+  bool mHasBackSnapshot;
+
+  bool mPipelined;
+  bool mDebugDraw;
+  std::unique_ptr<BackgroundThread> mTickThread;
+
   void onSpawnBullet(HEADING heading, OBJECT_TYPE type,
                      const sf::Vector2f &position);
 
   using PhysicalBodyVector = std::vector<std::unique_ptr<PhysicalBody>>;
   using PhysicalBodyMap = std::map<const OBJECT_TYPE, PhysicalBodyVector>;
 
-  void initPhysics(size_t currentLevel);
+  void initPhysics(const LevelParser &levelParser);
+
+  void simulate(sf::Time dt);
+  void waitForTick() const;
+  void finishTick();
+  void captureSnapshot();
+
+  void updateEntities(sf::Time dt);
+  void applyCommands();
 
+  void savePreviousState();
   void updateView();
+  void updateSimulationRegion();
   void updateSoundListener();
 
   void draw(sf::RenderTarget &target, sf::RenderStates states) const final;
@@ -0,0 +1,80 @@
+#ifndef WORLDSNAPSHOT_H
+#define WORLDSNAPSHOT_H
+
+#include "resourceManager.h"
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/NonCopyable.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <memory>
+#include <vector>
+
+class Entity;
+class SpriteBatch;
+
+namespace sf {
+class RenderTarget;
+class Texture;
+} // namespace sf
+
+// lower layers are drawn first
+enum class DRAW_LAYER { ENTITIES, BULLETS, PLAYER };
+
+// everything World::draw needs from one tick, so that the next tick can be
+// simulated on another thread while this one is drawn
+class WorldSnapshot : private sf::NonCopyable {
+public:
+  WorldSnapshot();
+  ~WorldSnapshot();
+
+  void clear();
+
+  void addEntity(const Entity &entity, DRAW_LAYER layer);
+  void setViewCenter(const sf::Vector2f &previous,
+                     const sf::Vector2f &current);
+  void setOutcome(bool failed, bool success);
+
+  sf::Vector2f getViewCenter(float interpolation) const;
+  bool failed() const;
+  bool success() const;
+
+  // one draw call per layer and texture; entities outside the view of
+  // the target are not submitted
+  void drawEntities(sf::RenderTarget &target, sf::RenderStates states,
+                    float interpolation) const;
+
+  // entities submitted by the last drawEntities
+  size_t getDrawnEntityCount() const;
+
+private:
+  struct EntityState {
+    // keeps the texture resident after the entity is destroyed by a tick
+    // running while the snapshot is drawn
+    TextureHandle mTexture;
+    sf::IntRect mTextureRect;
+    DRAW_LAYER mLayer;
+    sf::Transform mTransform;
+
+    // frame rectangle under mTransform, in world coordinates
+    sf::FloatRect mBounds;
+
+    // previous position minus the current one
+    sf::Vector2f mPreviousOffset;
+  };
+
+  std::vector<EntityState> mEntities;
+
+  sf::Vector2f mPreviousViewCenter;
+  sf::Vector2f mViewCenter;
+
+  bool mFailed;
+  bool mSuccess;
+
+  std::unique_ptr<SpriteBatch> mBatch;
+  mutable size_t mDrawnEntityCount;
+};
+
+#endif // WORLDSNAPSHOT_H
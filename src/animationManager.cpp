@@ -12,10 +12,16 @@
 
 AnimationManager::AnimationManager(const std::string &textureName)
     : mAnimations(), mCurrentAnimation(mAnimations.cend()),
-      mHeading(HEADING::NONE), mSprite() {
+      mHeading(HEADING::NONE), mTexture(), mSprite() {
   CHECK(!textureName.empty());
 
-  mSprite = makeUnique<sf::Sprite>(ResourceManager::getTexture(textureName));
+  // the sheet stays resident while an entity using it is alive
+  mTexture = ResourceManager::acquireTexture(textureName);
+
+  // headless entities are never drawn and have no texture
+  if (mTexture != nullptr) {
+    mSprite = makeUnique<sf::Sprite>(*mTexture);
+  }
 }
 
 AnimationManager::~AnimationManager() {}
@@ -101,6 +107,19 @@ const sf::IntRect &AnimationManager::getCurrentFrame() const {
   return mCurrentAnimation->second->getCurrentFrame();
 }
 
+sf::IntRect AnimationManager::getTextureRect() const {
+  auto frame = getCurrentFrame();
+
+  if (getHeading() == HEADING::LEFT) {
+    frame.left += frame.width;
+    frame.width *= -1;
+  }
+
+  return frame;
+}
+
+const TextureHandle &AnimationManager::getTexture() const { return mTexture; }
+
 sf::Time AnimationManager::getDuration() const {
   CHECK(hasChosenAnimation());
 
@@ -152,15 +171,9 @@ void AnimationManager::update(sf::Time dt) const {
 void AnimationManager::draw(sf::RenderTarget &target,
                             sf::RenderStates states) const {
   CHECK(hasChosenAnimation());
+  NOT_NULL(mSprite);
 
-  auto frame = getCurrentFrame();
-
-  if (getHeading() == HEADING::LEFT) {
-    frame.left += frame.width;
-    frame.width *= -1;
-  }
-
-  mSprite->setTextureRect(frame);
+  mSprite->setTextureRect(getTextureRect());
   target.draw(*mSprite, states);
 }
 
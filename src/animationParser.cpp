@@ -11,8 +11,6 @@
 
 #include "tinyxml.h"
 
-#include <SFML/Graphics/Texture.hpp>
-
 #include <set>
 
 std::unique_ptr<const AnimationParser> AnimationParser::mInstance;
@@ -111,9 +109,15 @@ AnimationParser::AnimationParser() : mManagerDataMap() {
 void AnimationParser::parseFile(const ObjectPair &objPair) {
   CHECK(mManagerDataMap.find(objPair.second) == mManagerDataMap.cend());
 
+  // the atlas packer output replaces the separate sprite sheets
+  const auto fileName = objPair.first + mObjFileExtension;
+  const auto atlasFile = ATLAS_ENTITIES_DIR + fileName;
+  const auto file = validateFile(atlasFile.c_str()) ? atlasFile
+                                                    : ENTITIES_DIR + fileName;
+
   TiXmlDocument doc;
 
-  CHECK(doc.LoadFile(ENTITIES_DIR + objPair.first + mObjFileExtension));
+  CHECK(doc.LoadFile(file));
 
   TiXmlElement *const spritesElem = doc.FirstChildElement(mSpritesElemName);
 
@@ -123,8 +127,8 @@ void AnimationParser::parseFile(const ObjectPair &objPair) {
 
   NOT_NULL(textureName);
 
-  const auto &texture = ResourceManager::getTexture(*textureName);
-  const auto textureSize = static_cast<sf::Vector2i>(texture.getSize());
+  const auto textureSize =
+      static_cast<sf::Vector2i>(ResourceManager::getTextureSize(*textureName));
 
   const auto insertResult =
       mManagerDataMap.emplace(objPair.second, ManagerData{});
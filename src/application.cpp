@@ -3,42 +3,92 @@
 #include "application.h"
 #include "core.h"
 #include "inputManager.h"
+#include "launchOptions.h"
+#include "profiler.h"
 #include "resourceManager.h"
 #include "stateManager.h"
 #include "utils.h"
 
 #include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/System/Sleep.hpp>
 #include <SFML/Window/Event.hpp>
 
 const sf::Time Application::mFrameDuration = sf::seconds(1.f / FRAMERATE);
+const sf::Time Application::mMinRenderDuration =
+    sf::seconds(1.f / MAX_RENDER_FRAMERATE);
+const size_t Application::mMaxTicksPerFrame = 5u;
+const sf::Keyboard::Key Application::mProfilerToggleKey = sf::Keyboard::F3;
 
-Application::Application()
+Application::Application(const LaunchOptions &options)
     : mWindow(nullptr), mStateManager(makeUnique<StateManager>()), mClock(),
-      mTimeSincePrevFrame() {
+      mTimeSincePrevFrame(), mProfileFile(options.mProfileFile) {
   ResourceManager::createInstance();
+
+  if (options.mMemoryBudget > 0) {
+    ResourceManager::setMemoryBudget(options.mMemoryBudget * 1024u * 1024u);
+  }
+
   InputManager::createInstance();
+  Profiler::createInstance();
+  Profiler::setEnabled(options.mProfile);
+
+  mStateManager->setPipelined(options.mPipelined);
+
+  if (!options.mRecordFile.empty()) {
+    InputManager::startRecording(options.mRecordFile);
+  }
 
   mWindow = &ResourceManager::getWindow();
 
-  mWindow->setFramerateLimit(FRAMERATE);
+  // render rate follows the display, simulation rate is fixed
   mWindow->setVerticalSyncEnabled(true);
   mWindow->setKeyRepeatEnabled(false);
 }
 
+Application::~Application() {}
+
 void Application::run() {
   while (mWindow->isOpen()) {
-    mTimeSincePrevFrame += mClock.restart();
+    // also includes the time spent waiting for the display
+    const auto frameTime = mClock.restart();
+    mTimeSincePrevFrame += frameTime;
 
-    while (mTimeSincePrevFrame > mFrameDuration) {
-      mTimeSincePrevFrame -= mFrameDuration;
+    handleEvents();
 
-      handleEvents();
+    size_t tickCount = 0;
 
-      // uniform update
+    // uniform update
+    while (mTimeSincePrevFrame >= mFrameDuration) {
+      // drop the time that can't be caught up to avoid a spiral of death
+      if (tickCount == mMaxTicksPerFrame) {
+        mTimeSincePrevFrame %= mFrameDuration;
+        break;
+      }
+
+      mTimeSincePrevFrame -= mFrameDuration;
       update(mFrameDuration);
-      render();
+      tickCount++;
+    }
+
+    const auto tickTime = mClock.getElapsedTime();
+
+    render(mTimeSincePrevFrame / mFrameDuration);
+
+    const auto workTime = mClock.getElapsedTime();
+
+    mStateManager->addFrame(frameTime, tickTime, workTime - tickTime);
+
+    // yield if vertical sync is not honoured by the driver
+    if (workTime < mMinRenderDuration) {
+      sf::sleep(mMinRenderDuration - workTime);
     }
   }
+
+  InputManager::stopRecording();
+
+  if (Profiler::isEnabled()) {
+    Profiler::dump(mProfileFile);
+  }
 }
 
 void Application::handleEvents() {
@@ -50,20 +100,37 @@ void Application::handleEvents() {
       break;
     }
 
+    if (event.type == sf::Event::KeyPressed &&
+        event.key.code == mProfilerToggleKey) {
+      toggleProfiler();
+      continue;
+    }
+
     mStateManager->handleEvent(event);
   }
 }
 
-void Application::update(sf::Time dt) { mStateManager->update(dt); }
+void Application::toggleProfiler() {
+  Profiler::setEnabled(!Profiler::isEnabled());
 
-void Application::render() const {
-  mWindow->clear();
-  mWindow->draw(*mStateManager);
-  mWindow->display();
+  // the capture is saved once it is stopped
+  if (!Profiler::isEnabled()) {
+    Profiler::dump(mProfileFile);
+  }
+}
+
+void Application::update(sf::Time dt) {
+  PROFILE_SCOPE("Application::update");
+
+  mStateManager->update(dt);
 }
 
-int main() {
-  makeUnique<Application>()->run();
+void Application::render(float interpolation) const {
+  PROFILE_SCOPE("Application::render");
 
-  return 0;
+  mStateManager->setInterpolation(interpolation);
+
+  mWindow->clear();
+  mWindow->draw(*mStateManager);
+  mWindow->display();
 }
@@ -6,11 +6,25 @@
 #include "core.h"
 #include "objectType.h"
 #include "physicalBody.h"
+#include "physicalWorld.h"
+#include "utils.h"
 
 #include <SFML/Graphics/RenderTarget.hpp>
 
 #include <Box2D/Dynamics/b2Fixture.h>
 
+namespace {
+// what a ray from the archer stops at; it sees the player if that comes first
+const PhysicalWorld::TypeMask SIGHT_MASK =
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::PLAYER) |
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::SOLID) |
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::SLOPE_LEFT) |
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::SLOPE_RIGHT) |
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::SOLID_ON_LADDER) |
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::HORIZONTAL_PLATFORM) |
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::VERTICAL_PLATFORM);
+} // unnamed namespace
+
 const int Archer::mArcherHitpoints = 1;
 const OBJECT_TYPE Archer::mArcherType = OBJECT_TYPE::ARCHER;
 const ANIMATION_TYPE Archer::mArcherAnimationType = ANIMATION_TYPE::ARCHER;
@@ -22,10 +36,12 @@ const sf::Vector2f Archer::mBulletRightOffset = {38.f, 5.f};
 const sf::Vector2f Archer::mBulletLeftOffset = {-38.f, 5.f};
 const float Archer::mHiddenHeight = 9.f;
 
+const sf::Vector2f Archer::mSightHalfSize = {480.f, 48.f};
+
 Archer::Archer(std::unique_ptr<PhysicalBody> body)
     : Shooter{mArcherHitpoints, mArcherType, mArcherAnimationType,
               HEADING::RIGHT},
-      mPhysBody(), mShootingCountdown(sf::Time::Zero) {
+      mPhysBody(), mShootingCountdown(sf::Time::Zero), mPlayerPositions() {
   NOT_NULL(body);
   CHECK(body->getType() == mArcherType);
 
@@ -37,7 +53,7 @@ Archer::Archer(std::unique_ptr<PhysicalBody> body)
   NOT_NULL(fixture);
   IS_NULL(fixture->GetNext());
 
-  fixture->SetUserData(getUserData());
+  setFixtureUserData(fixture, *getUserData());
   setEntityPosition(rawBody);
 }
 
@@ -46,13 +62,48 @@ void Archer::update(sf::Time dt) {
     mShootingCountdown -= dt;
   }
 
+  sf::Vector2f playerPosition;
+  const bool playerVisible = findVisiblePlayer(playerPosition);
+
+  if (playerVisible) {
+    setHeading(getPosition().x < playerPosition.x ? HEADING::RIGHT
+                                                  : HEADING::LEFT);
+  }
+
   getAnimationManager().update(dt);
   setEntityPosition(mPhysBody->getBody());
-  spawnBullet();
+
+  if (playerVisible) {
+    spawnBullet();
+  }
 }
 
 OBJECT_TYPE Archer::getType() const { return mArcherType; }
 
+b2Body *Archer::getBody() const { return &mPhysBody->getBody(); }
+
+bool Archer::findVisiblePlayer(sf::Vector2f &playerPosition) {
+  const auto &physicalWorld = mPhysBody->getPhysicalWorld();
+  const auto &position = getPosition();
+
+  mPlayerPositions.clear();
+  physicalWorld.queryArea({position - mSightHalfSize, mSightHalfSize * 2.f},
+                          PhysicalWorld::getTypeMask(OBJECT_TYPE::PLAYER),
+                          mPlayerPositions);
+
+  for (const auto &candidate : mPlayerPositions) {
+    PhysicalWorld::RayHit hit;
+
+    if (physicalWorld.castRay(position, candidate, SIGHT_MASK, hit) &&
+        hit.mType == OBJECT_TYPE::PLAYER) {
+      playerPosition = candidate;
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void Archer::spawnBullet() {
   if (mShootingCountdown > sf::Time::Zero) {
     return;
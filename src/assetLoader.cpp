@@ -0,0 +1,100 @@
+#define LOG_TAG "AssetLoader"
+
+#include "assetLoader.h"
+#include "animationParser.h"
+#include "backgroundThread.h"
+#include "button.h"
+#include "core.h"
+#include "introState.h"
+#include "resourceManager.h"
+#include "utils.h"
+#include "workerPool.h"
+
+AssetLoader::AssetLoader()
+    : mTasks(), mFinishedTaskCount(0u), mDecoded(false), mUploads(),
+      mUploadedCount(0u), mUploadsListed(false),
+      mWorkerPool(makeUnique<WorkerPool>(WorkerPool::getDefaultThreadCount())),
+      mThread(makeUnique<BackgroundThread>()) {
+  CHECK(!ResourceManager::isHeadless());
+
+  addTasks();
+
+  mThread->run([this] { decode(); });
+}
+
+AssetLoader::~AssetLoader() { mThread->wait(); }
+
+void AssetLoader::update() {
+  if (!mDecoded) {
+    return;
+  }
+
+  if (!mUploadsListed) {
+    mUploads = ResourceManager::getDecodedTextures();
+    mUploadsListed = true;
+
+    LOG("%zu tasks decoded, %zu textures to upload", mTasks.size(),
+        mUploads.size());
+  }
+
+  // one upload per tick keeps the progress drawn while uploading
+  if (mUploadedCount < mUploads.size()) {
+    ResourceManager::uploadTexture(mUploads[mUploadedCount]);
+    mUploadedCount++;
+  }
+}
+
+bool AssetLoader::isDone() const {
+  return mUploadsListed && mUploadedCount == mUploads.size();
+}
+
+float AssetLoader::getProgress() const {
+  if (!mUploadsListed) {
+    return 0.5f * mFinishedTaskCount / mTasks.size();
+  }
+
+  if (mUploads.empty()) {
+    return 1.f;
+  }
+
+  return 0.5f + 0.5f * mUploadedCount / mUploads.size();
+}
+
+void AssetLoader::addTasks() {
+  // later levels are loaded on demand by the world, within the memory budget
+  mTasks.push_back([] {
+    for (const auto &filename : ResourceManager::getLevelManifest(0)) {
+      ResourceManager::decodeTexture(filename);
+    }
+  });
+
+  // the sheets are decoded while their frames are checked
+  mTasks.push_back([] { AnimationParser::createInstance(); });
+
+  for (const auto &filename : {STATE_TEXTURE_NAME,
+                               IntroState::mRollingTextureName,
+                               Button::mTextureName}) {
+    mTasks.push_back([filename] { ResourceManager::decodeTexture(filename); });
+  }
+
+  // pinned for the whole run and shared by every state
+  for (const auto &filename : ResourceManager::getFontNames()) {
+    mTasks.push_back([filename] { ResourceManager::getFont(filename); });
+  }
+
+  for (const auto &filename : ResourceManager::getSoundNames()) {
+    mTasks.push_back([filename] { ResourceManager::getSoundBuffer(filename); });
+  }
+}
+
+void AssetLoader::decode() {
+  mWorkerPool->parallelFor(mTasks.size(), [this](size_t /*chunk*/,
+                                                 size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      mTasks[i]();
+      mFinishedTaskCount++;
+    }
+  });
+
+  mDecoded = true;
+}
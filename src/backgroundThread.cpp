@@ -0,0 +1,67 @@
+#define LOG_TAG "BackgroundThread"
+
+#include "backgroundThread.h"
+#include "core.h"
+
+// the thread starts last, when the state it reads is initialized
+BackgroundThread::BackgroundThread()
+    : mMutex(), mJobReady(), mJobDone(), mJob(), mBusy(false),
+      mStopping(false), mThread(&BackgroundThread::threadLoop, this) {}
+
+BackgroundThread::~BackgroundThread() {
+  wait();
+
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mStopping = true;
+  }
+
+  mJobReady.notify_one();
+  mThread.join();
+}
+
+void BackgroundThread::run(const Job &job) {
+  CHECK(job);
+
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    CHECK(!mBusy);
+
+    mJob = job;
+    mBusy = true;
+  }
+
+  mJobReady.notify_one();
+}
+
+void BackgroundThread::wait() {
+  std::unique_lock<std::mutex> lock{mMutex};
+  mJobDone.wait(lock, [this] { return !mBusy; });
+}
+
+void BackgroundThread::threadLoop() {
+  while (true) {
+    Job job;
+
+    {
+      std::unique_lock<std::mutex> lock{mMutex};
+      mJobReady.wait(lock, [this] { return mStopping || mBusy; });
+
+      if (mStopping) {
+        return;
+      }
+
+      job.swap(mJob);
+    }
+
+    job();
+
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      mBusy = false;
+    }
+
+    mJobDone.notify_all();
+  }
+}
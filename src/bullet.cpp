@@ -2,6 +2,7 @@
 
 #include "bullet.h"
 #include "animationManager.h"
+#include "animationParser.h"
 #include "animationType.h"
 #include "core.h"
 #include "objectType.h"
@@ -17,7 +18,8 @@ const float Bullet::mBulletVelocity = 400.f;
 Bullet::Bullet(HEADING heading, std::unique_ptr<PhysicalBody> body)
     : Entity{mBulletHitpoints, body->getType(),
              objToAnimationType(body->getType()), heading},
-      mType(OBJECT_TYPE::NONE), mPhysBody(), mExplodeCountdown(sf::Time::Zero) {
+      mType(OBJECT_TYPE::NONE), mPhysBody(), mSpareAnimationManager(),
+      mExplodeCountdown(sf::Time::Zero) {
   NOT_NULL(body);
 
   const auto type = body->getType();
@@ -34,7 +36,7 @@ Bullet::Bullet(HEADING heading, std::unique_ptr<PhysicalBody> body)
   NOT_NULL(fixture);
   IS_NULL(fixture->GetNext());
 
-  fixture->SetUserData(getUserData());
+  setFixtureUserData(fixture, *getUserData());
   setEntityPosition(rawBody);
 
   const auto velocityInMeters = toB2Coords(b2Vec2{
@@ -42,6 +44,53 @@ Bullet::Bullet(HEADING heading, std::unique_ptr<PhysicalBody> body)
   rawBody.SetLinearVelocity(velocityInMeters);
   rawBody.SetBullet(true);
   rawBody.SetGravityScale(0.f);
+
+  // built once, so that the explosion doesn't allocate
+  const auto explodedType = OBJECT_TYPE::EXPLODED_BULLET;
+  mSpareAnimationManager = AnimationParser::createManagerFor(explodedType);
+  mSpareAnimationManager->chooseAnimation(objToAnimationType(explodedType),
+                                          heading);
+  mSpareAnimationManager->setLoop(false);
+  mSpareAnimationManager->start();
+}
+
+Bullet::~Bullet() {}
+
+void Bullet::reset(HEADING heading, const sf::Vector2f &position) {
+  // pooled bullet has either exploded or never been fired
+  if (mType == OBJECT_TYPE::EXPLODED_BULLET) {
+    CHECK(isDestroyed());
+
+    swapAnimationManager(mSpareAnimationManager);
+  }
+
+  mType = getBulletType();
+  mExplodeCountdown = sf::Time::Zero;
+  revive();
+
+  setHeading(heading);
+
+  auto &animationManager = getAnimationManager();
+  animationManager.stop();
+  animationManager.start();
+
+  centerOrigin();
+
+  auto &rawBody = mPhysBody->getBody();
+  rawBody.SetTransform(toB2Coords(b2Vec2{position.x, position.y}), 0.f);
+  rawBody.SetLinearVelocity(toB2Coords(b2Vec2{
+      heading == HEADING::RIGHT ? mBulletVelocity : -mBulletVelocity, 0.f}));
+  rawBody.SetActive(true);
+  rawBody.SetAwake(true);
+
+  setEntityPosition(rawBody);
+  savePreviousPosition();
+}
+
+void Bullet::deactivate() {
+  auto &rawBody = mPhysBody->getBody();
+  rawBody.SetLinearVelocity({0.f, 0.f});
+  rawBody.SetActive(false);
 }
 
 void Bullet::update(sf::Time dt) {
@@ -51,16 +100,18 @@ void Bullet::update(sf::Time dt) {
     } else if (getType() != OBJECT_TYPE::EXPLODED_BULLET) {
       mType = OBJECT_TYPE::EXPLODED_BULLET;
 
-      initAnimationManager(mType, objToAnimationType(mType), getHeading());
+      const auto heading = getHeading();
+      swapAnimationManager(mSpareAnimationManager);
+      setHeading(heading);
 
+      // replay the explosion from the first frame
       auto &newAnimationManager = getAnimationManager();
-      newAnimationManager.setLoop(false);
+      newAnimationManager.stop();
+      newAnimationManager.start();
 
       mExplodeCountdown = newAnimationManager.getDuration();
 
-      auto &rawBody = mPhysBody->getBody();
-      rawBody.SetLinearVelocity({0.f, 0.f});
-      rawBody.SetActive(false);
+      deactivate();
 
       SoundPlayer::play("Explosion.wav", getPosition());
     } else {
@@ -82,6 +133,10 @@ bool Bullet::isDestroyed() const {
 
 OBJECT_TYPE Bullet::getType() const { return mType; }
 
+b2Body *Bullet::getBody() const { return &mPhysBody->getBody(); }
+
+OBJECT_TYPE Bullet::getBulletType() const { return mPhysBody->getType(); }
+
 ANIMATION_TYPE Bullet::objToAnimationType(OBJECT_TYPE type) const {
   switch (type) {
   case OBJECT_TYPE::ALLIED_BULLET:
@@ -0,0 +1,95 @@
+#define LOG_TAG "BulletPool"
+
+#include "bulletPool.h"
+#include "animationManager.h"
+#include "bullet.h"
+#include "core.h"
+#include "objectType.h"
+#include "physicalBody.h"
+#include "utils.h"
+
+const sf::Vector2f BulletPool::mBulletSize = {10.f, 10.f};
+
+BulletPool::BulletPool(PhysicalWorld &physicalWorld, size_t prewarmCount,
+                       size_t capacity)
+    : mPhysicalWorld(physicalWorld), mCapacity(capacity), mIdleBullets(),
+      mHitCount(0), mMissCount(0) {
+  CHECK(prewarmCount <= capacity);
+
+  for (const auto type :
+       {OBJECT_TYPE::ALLIED_BULLET, OBJECT_TYPE::ENEMY_BULLET}) {
+    auto &idleBullets = mIdleBullets[type];
+    idleBullets.reserve(capacity);
+
+    for (size_t i = 0; i < prewarmCount; i++) {
+      auto bullet = create(type, HEADING::RIGHT, {0.f, 0.f});
+      bullet->deactivate();
+
+      idleBullets.push_back(std::move(bullet));
+    }
+  }
+}
+
+BulletPool::~BulletPool() {
+  LOG("%zu hits, %zu misses, %zu idle", mHitCount, mMissCount,
+      getIdleCount());
+}
+
+std::unique_ptr<Bullet> BulletPool::acquire(OBJECT_TYPE type, HEADING heading,
+                                            const sf::Vector2f &position) {
+  const auto it = mIdleBullets.find(type);
+
+  CHECK(it != mIdleBullets.cend());
+
+  auto &idleBullets = it->second;
+
+  if (idleBullets.empty()) {
+    mMissCount++;
+
+    return create(type, heading, position);
+  }
+
+  mHitCount++;
+
+  auto bullet = std::move(idleBullets.back());
+  idleBullets.pop_back();
+  bullet->reset(heading, position);
+
+  return bullet;
+}
+
+void BulletPool::release(std::unique_ptr<Bullet> bullet) {
+  NOT_NULL(bullet);
+  CHECK(bullet->isDestroyed());
+
+  const auto it = mIdleBullets.find(bullet->getBulletType());
+
+  CHECK(it != mIdleBullets.cend());
+
+  // the bullet is destroyed with its body once the pool is full
+  if (it->second.size() < mCapacity) {
+    it->second.push_back(std::move(bullet));
+  }
+}
+
+size_t BulletPool::getHitCount() const { return mHitCount; }
+
+size_t BulletPool::getMissCount() const { return mMissCount; }
+
+size_t BulletPool::getIdleCount() const {
+  size_t count = 0;
+
+  for (const auto &pair : mIdleBullets) {
+    count += pair.second.size();
+  }
+
+  return count;
+}
+
+std::unique_ptr<Bullet> BulletPool::create(OBJECT_TYPE type, HEADING heading,
+                                           const sf::Vector2f &position) const {
+  const sf::FloatRect bounds = {position, mBulletSize};
+  auto body = makeUnique<PhysicalBody>(mPhysicalWorld, bounds, type);
+
+  return makeUnique<Bullet>(heading, std::move(body));
+}
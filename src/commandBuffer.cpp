@@ -0,0 +1,34 @@
+#define LOG_TAG "CommandBuffer"
+
+#include "commandBuffer.h"
+#include "core.h"
+
+namespace {
+thread_local CommandBuffer *currentBuffer = nullptr;
+} // unnamed namespace
+
+CommandBuffer::Binding::Binding(CommandBuffer &buffer)
+    : mPrevious(currentBuffer) {
+  currentBuffer = &buffer;
+}
+
+CommandBuffer::Binding::~Binding() { currentBuffer = mPrevious; }
+
+CommandBuffer::CommandBuffer() : mCommands() {}
+
+CommandBuffer &CommandBuffer::getCurrent() {
+  NOT_NULL(currentBuffer);
+
+  return *currentBuffer;
+}
+
+void CommandBuffer::spawnBullet(HEADING heading, OBJECT_TYPE type,
+                                const sf::Vector2f &position) {
+  mCommands.push_back({COMMAND_TYPE::SPAWN_BULLET, heading, type, position});
+}
+
+const std::vector<CommandBuffer::Command> &CommandBuffer::getCommands() const {
+  return mCommands;
+}
+
+void CommandBuffer::clear() { mCommands.clear(); }
@@ -16,7 +16,9 @@
 
 Entity::Entity(int maxHitpoints, OBJECT_TYPE objectType,
                ANIMATION_TYPE animationType, HEADING heading)
-    : mMaxHitpoints(0), mHitpoints(0), mUserData(this), mAnimationManager() {
+    : mMaxHitpoints(0), mHitpoints(0), mVelocity(), mPreviousPosition(),
+      mHasPreviousPosition(false), mSimulated(true), mUserData(this),
+      mAnimationManager() {
   CHECK(maxHitpoints > 0);
 
   mHitpoints = mMaxHitpoints = maxHitpoints;
@@ -94,6 +96,53 @@ HEADING Entity::getHeading() const {
   return getAnimationManager().getHeading();
 }
 
+void Entity::savePreviousPosition() {
+  mPreviousPosition = getPosition();
+  mHasPreviousPosition = true;
+}
+
+sf::Vector2f Entity::getInterpolationOffset(float interpolation) const {
+  // entity spawned during the last tick has nothing to blend with
+  if (!mHasPreviousPosition) {
+    return {0.f, 0.f};
+  }
+
+  return interpolate(mPreviousPosition, getPosition(), interpolation) -
+         getPosition();
+}
+
+sf::Transform Entity::getRenderTransform() const {
+  sf::RenderStates states;
+  states.transform = getTransform();
+
+  onDraw(states);
+
+  return states.transform;
+}
+
+const TextureHandle &Entity::getTexture() const {
+  return getAnimationManager().getTexture();
+}
+
+sf::IntRect Entity::getTextureRect() const {
+  return getAnimationManager().getTextureRect();
+}
+
+void Entity::setSimulated(bool simulated) {
+  if (mSimulated == simulated) {
+    return;
+  }
+
+  b2Body *const body = getBody();
+
+  NOT_NULL(body);
+
+  mSimulated = simulated;
+  body->SetActive(simulated);
+}
+
+bool Entity::isSimulated() const { return mSimulated; }
+
 void Entity::initAnimationManager(OBJECT_TYPE objectType,
                                   ANIMATION_TYPE animationType,
                                   HEADING heading) {
@@ -108,6 +157,15 @@ void Entity::initAnimationManager(OBJECT_TYPE objectType,
   centerOrigin();
 }
 
+void Entity::swapAnimationManager(
+    std::unique_ptr<AnimationManager> &manager) {
+  NOT_NULL(manager);
+
+  mAnimationManager.swap(manager);
+}
+
+void Entity::revive() { mHitpoints = mMaxHitpoints; }
+
 AnimationManager &Entity::getAnimationManager() const {
   NOT_NULL(mAnimationManager);
 
@@ -124,6 +182,8 @@ void Entity::setEntityPosition(const b2Body &body) {
   setPosition({posInPixels.x, posInPixels.y});
 }
 
+b2Body *Entity::getBody() const { return nullptr; }
+
 void Entity::onDraw(sf::RenderStates & /*states*/) const {}
 
 void Entity::draw(sf::RenderTarget &target, sf::RenderStates states) const {
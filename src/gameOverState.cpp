@@ -42,7 +42,7 @@ const ComponentDefinition GameOverState::mGoToMenuButtonDefinition{
     "Go to menu", {0.8f * WINDOW_WIDTH, 0.9f * WINDOW_HEIGHT}};
 
 GameOverState::GameOverState(StateManager &stateManager)
-    : StateBase{stateManager}, mHeaderLabel(), mButtonView(),
+    : StateBase{stateManager}, mHeaderLabel(), mButtonView(), mTexture(),
       mSprite(makeUnique<sf::Sprite>()), mAnimatedEntity(),
       mAnimationInProgress(true) {
   const AnimatedEntity::OnFinishCallback entityCallback = [this] {
@@ -53,7 +53,7 @@ GameOverState::GameOverState(StateManager &stateManager)
 
   if (stateManager.getCurrentLevel() < ResourceManager::getLevelCount()) {
     mHeaderLabel = makeUnique<Label>(mHeaderLabelFailureDefinition);
-    mSprite->setTexture(ResourceManager::getTexture(mFailureTextureName));
+    mTexture = ResourceManager::acquireTexture(mFailureTextureName);
     mAnimatedEntity =
         makeUnique<AnimatedEntity>(AnimatedEntity::FAILURE, entityCallback);
     mAnimatedEntity->setPosition(mEntityInitPositionFailure);
@@ -63,12 +63,15 @@ GameOverState::GameOverState(StateManager &stateManager)
     });
   } else {
     mHeaderLabel = makeUnique<Label>(mHeaderLabelSuccessDefinition);
-    mSprite->setTexture(ResourceManager::getTexture(mSuccessTextureName));
+    mTexture = ResourceManager::acquireTexture(mSuccessTextureName);
     mAnimatedEntity =
         makeUnique<AnimatedEntity>(AnimatedEntity::SUCCESS, entityCallback);
     mAnimatedEntity->setPosition(mEntityInitPositionSuccess);
   }
 
+  // the ending pictures are shown once and may be evicted afterwards
+  mSprite->setTexture(*mTexture);
+
   buttons.emplace_back(mGoToMenuButtonDefinition, [this] {
     getStateManager().requestStateTranstion(STATE_TYPE::MENU);
   });
@@ -8,20 +8,32 @@
 #include "utils.h"
 #include "world.h"
 
-#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/System/Time.hpp>
 #include <SFML/Window/Event.hpp>
 
+const sf::Keyboard::Key GameState::mDebugDrawToggleKey = sf::Keyboard::F2;
+
 GameState::GameState(StateManager &stateManager)
     : StateBase(stateManager),
-      mWorld(makeUnique<World>(stateManager.getCurrentLevel())) {}
+      mWorld(makeUnique<World>(stateManager.getCurrentLevel())),
+      mSceneSprite(makeUnique<sf::Sprite>(stateManager.getSceneTexture())) {
+  mWorld->setPipelined(stateManager.isPipelined());
+}
 
-GameState::~GameState() { setDefaultView(); }
+GameState::~GameState() {}
 
 void GameState::handleEvent(const sf::Event &event) {
+  if (event.type == sf::Event::KeyPressed &&
+      event.key.code == mDebugDrawToggleKey) {
+    mWorld->toggleDebugDraw();
+    return;
+  }
+
   if (event.type == sf::Event::LostFocus ||
       (event.type == sf::Event::KeyPressed &&
        event.key.code == sf::Keyboard::Escape)) {
-    setDefaultView();
     getStateManager().requestStateTranstion(STATE_TYPE::PAUSE);
   }
 }
@@ -44,11 +56,19 @@ void GameState::update(sf::Time dt) {
   }
 }
 
-void GameState::setDefaultView() const {
-  auto &window = ResourceManager::getWindow();
-  window.setView(window.getDefaultView());
+void GameState::setInterpolation(float interpolation) {
+  mWorld->setInterpolation(interpolation);
 }
 
+const World *GameState::getWorld() const { return mWorld.get(); }
+
 void GameState::draw(sf::RenderTarget &target, sf::RenderStates states) const {
-  target.draw(*mWorld, states);
+  // the world moves the view of the scene, the window keeps the default one
+  auto &scene = getStateManager().getScene();
+
+  scene.clear();
+  scene.draw(*mWorld);
+  scene.display();
+
+  target.draw(*mSceneSprite, states);
 }
@@ -0,0 +1,216 @@
+#define LOG_TAG "GeometryBaker"
+
+#include "geometryBaker.h"
+#include "core.h"
+#include "levelParser.h"
+
+#include <cmath>
+#include <map>
+
+namespace {
+// TMX coordinates are floats, tile-aligned ones are whole multiples
+const float GRID_EPSILON = 1e-3f;
+
+bool snapToGrid(float value, float gridSize, int &result) {
+  const float cells = value / gridSize;
+  const float rounded = std::round(cells);
+
+  result = static_cast<int>(rounded);
+
+  return std::fabs(cells - rounded) < GRID_EPSILON;
+}
+
+int sign(int value) { return (value > 0) - (value < 0); }
+} // unnamed namespace
+
+GeometryBaker::GeometryBaker(unsigned int gridSize)
+    : mGridSize(static_cast<float>(gridSize)), mCells(), mEdges(),
+      mShapeCount(0) {
+  CHECK(gridSize > 0);
+}
+
+bool GeometryBaker::addRectangle(const sf::FloatRect &rect) {
+  sf::IntRect gridRect;
+
+  if (!toGrid(rect, gridRect) || !occupy(gridRect)) {
+    return false;
+  }
+
+  const int right = gridRect.left + gridRect.width;
+  const int bottom = gridRect.top + gridRect.height;
+
+  addEdge({gridRect.left, gridRect.top}, {right, gridRect.top});
+  addEdge({right, gridRect.top}, {right, bottom});
+  addEdge({right, bottom}, {gridRect.left, bottom});
+  addEdge({gridRect.left, bottom}, {gridRect.left, gridRect.top});
+
+  mShapeCount++;
+
+  return true;
+}
+
+bool GeometryBaker::addSlope(const sf::FloatRect &rect, bool isSlopeLeft) {
+  sf::IntRect gridRect;
+
+  // the whole bounding box is taken, a slope can't share cells
+  if (!toGrid(rect, gridRect) || !occupy(gridRect)) {
+    return false;
+  }
+
+  const int right = gridRect.left + gridRect.width;
+  const int bottom = gridRect.top + gridRect.height;
+
+  // the vertical side is at the left of the left slope and vice versa
+  const Point top = {isSlopeLeft ? gridRect.left : right, gridRect.top};
+  const Point bottomLeft = {gridRect.left, bottom};
+  const Point bottomRight = {right, bottom};
+
+  addEdge(top, bottomRight);
+  addEdge(bottomRight, bottomLeft);
+  addEdge(bottomLeft, top);
+
+  mShapeCount++;
+
+  return true;
+}
+
+void GeometryBaker::addTiles(const TileMapInfo &info) {
+  CHECK(static_cast<float>(info.mTileSize) == mGridSize);
+
+  CHECK(!info.mLayers.empty());
+
+  // the bodies do not move with the view, so neither may the tiles they
+  // follow, and they are drawn at the depth of the entities they touch
+  const auto &layer = info.mLayers.front();
+
+  CHECK(layer.mParallax == sf::Vector2f(1.f, 1.f));
+  CHECK(layer.mDepth == 0);
+
+  const auto &size = info.mMapRectNum;
+  const auto &gids = layer.mGids;
+
+  for (unsigned int y = 0; y < size.y; y++) {
+    for (unsigned int x = 0; x < size.x; x++) {
+      if (gids[y * size.x + x] == 0) {
+        continue;
+      }
+
+      const sf::FloatRect tile = {x * mGridSize, y * mGridSize, mGridSize,
+                                  mGridSize};
+
+      CHECK(addRectangle(tile));
+    }
+  }
+}
+
+size_t GeometryBaker::getShapeCount() const { return mShapeCount; }
+
+std::vector<GeometryBaker::Outline> GeometryBaker::bake() const {
+  std::multimap<Point, Point> nextPoints;
+
+  for (const auto &edge : mEdges) {
+    nextPoints.emplace(edge.first, edge.second);
+  }
+
+  std::vector<Outline> outlines;
+
+  // every point has as many incoming edges as outgoing ones,
+  // so a walk from any edge comes back to its start
+  while (!nextPoints.empty()) {
+    const Point start = nextPoints.begin()->first;
+    Point current = start;
+    std::vector<Point> loop;
+
+    do {
+      const auto it = nextPoints.find(current);
+
+      CHECK(it != nextPoints.end());
+
+      loop.push_back(current);
+      current = it->second;
+      nextPoints.erase(it);
+    } while (current != start);
+
+    Outline outline;
+    const size_t count = loop.size();
+
+    for (size_t i = 0; i < count; i++) {
+      const Point &prev = loop[(i + count - 1) % count];
+      const Point &point = loop[i];
+      const Point &next = loop[(i + 1) % count];
+
+      const int cross =
+          (point.first - prev.first) * (next.second - point.second) -
+          (point.second - prev.second) * (next.first - point.first);
+
+      // points in the middle of a straight run are dropped
+      if (cross != 0) {
+        outline.emplace_back(point.first * mGridSize,
+                             point.second * mGridSize);
+      }
+    }
+
+    if (outline.size() >= 3) {
+      outlines.push_back(std::move(outline));
+    }
+  }
+
+  return outlines;
+}
+
+bool GeometryBaker::toGrid(const sf::FloatRect &rect,
+                           sf::IntRect &gridRect) const {
+  return snapToGrid(rect.left, mGridSize, gridRect.left) &&
+         snapToGrid(rect.top, mGridSize, gridRect.top) &&
+         snapToGrid(rect.width, mGridSize, gridRect.width) &&
+         snapToGrid(rect.height, mGridSize, gridRect.height) &&
+         gridRect.width > 0 && gridRect.height > 0;
+}
+
+bool GeometryBaker::occupy(const sf::IntRect &gridRect) {
+  const int right = gridRect.left + gridRect.width;
+  const int bottom = gridRect.top + gridRect.height;
+
+  for (int y = gridRect.top; y < bottom; y++) {
+    for (int x = gridRect.left; x < right; x++) {
+      if (mCells.find({x, y}) != mCells.cend()) {
+        return false;
+      }
+    }
+  }
+
+  for (int y = gridRect.top; y < bottom; y++) {
+    for (int x = gridRect.left; x < right; x++) {
+      mCells.emplace(x, y);
+    }
+  }
+
+  return true;
+}
+
+void GeometryBaker::addEdge(const Point &from, const Point &to) {
+  const bool axisAligned = from.first == to.first || from.second == to.second;
+
+  if (!axisAligned) {
+    addPiece(from, to);
+    return;
+  }
+
+  const Point step = {sign(to.first - from.first),
+                      sign(to.second - from.second)};
+
+  for (Point point = from; point != to;) {
+    const Point next = {point.first + step.first, point.second + step.second};
+
+    addPiece(point, next);
+    point = next;
+  }
+}
+
+void GeometryBaker::addPiece(const Point &from, const Point &to) {
+  // the same piece walked backwards belongs to a neighbour,
+  // both are inside the merged shape
+  if (mEdges.erase({to, from}) == 0) {
+    CHECK(mEdges.emplace(from, to).second);
+  }
+}
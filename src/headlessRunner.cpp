@@ -0,0 +1,101 @@
+#define LOG_TAG "HeadlessRunner"
+
+#include "headlessRunner.h"
+#include "core.h"
+#include "inputManager.h"
+#include "levelParser.h"
+#include "profiler.h"
+#include "resourceManager.h"
+#include "utils.h"
+#include "world.h"
+
+#include <SFML/System/Clock.hpp>
+
+const sf::Time HeadlessRunner::mTickDuration = sf::seconds(1.f / FRAMERATE);
+
+HeadlessRunner::HeadlessRunner(const LaunchOptions &options)
+    : mOptions(options) {
+  CHECK(mOptions.mHeadless);
+  CHECK(mOptions.mTickCount > 0);
+
+  ResourceManager::createHeadlessInstance();
+
+  if (mOptions.mMemoryBudget > 0) {
+    ResourceManager::setMemoryBudget(mOptions.mMemoryBudget * 1024u * 1024u);
+  }
+
+  Profiler::createInstance();
+  Profiler::setEnabled(mOptions.mProfile);
+
+  CHECK(mOptions.mLevel <= ResourceManager::getLevelCount());
+}
+
+void HeadlessRunner::run() {
+  if (!mOptions.mReplayFile.empty()) {
+    InputManager::startReplay(mOptions.mReplayFile);
+
+    for (size_t i = 0; i < InputManager::getReplayLevelCount(); i++) {
+      runLevel(InputManager::getReplayLevel(i));
+    }
+  } else if (!mOptions.mLevelFile.empty()) {
+    runLevelFile();
+  } else if (mOptions.mLevel > 0) {
+    runLevel(mOptions.mLevel - 1);
+  } else {
+    for (size_t level = 0; level < ResourceManager::getLevelCount();
+         level++) {
+      runLevel(level);
+    }
+  }
+
+  if (Profiler::isEnabled()) {
+    Profiler::dump(mOptions.mProfileFile);
+  }
+}
+
+void HeadlessRunner::runLevel(size_t level) const {
+  const auto world = makeUnique<World>(level);
+
+  simulate(*world, "level " + std::to_string(level + 1));
+}
+
+void HeadlessRunner::runLevelFile() const {
+  const LevelParser levelParser{mOptions.mLevelFile};
+
+  // headless mode has no textures, the background handle is empty
+  const auto world = makeUnique<World>(levelParser,
+                                       ResourceManager::getLevelTexture(0));
+
+  simulate(*world, mOptions.mLevelFile);
+}
+
+void HeadlessRunner::simulate(World &world, const std::string &title) const {
+  const auto entityCount = world.getEntityCount();
+
+  size_t tickCount = 0;
+  sf::Clock clock;
+
+  while (!levelFinished(world, tickCount)) {
+    world.update(mTickDuration);
+    tickCount++;
+  }
+
+  const auto elapsed = clock.getElapsedTime().asSeconds();
+  const auto ticksPerSecond = elapsed > 0.f ? tickCount / elapsed : 0.f;
+
+  LOG("%s: %zu entities, %zu ticks in %.3f s, %.1f ticks/s, %.3f ms/tick",
+      title.c_str(), entityCount, tickCount, elapsed,
+      ticksPerSecond, tickCount > 0 ? 1000.f * elapsed / tickCount : 0.f);
+}
+
+bool HeadlessRunner::levelFinished(const World &world, size_t tickCount) const {
+  if (world.failed() || world.success()) {
+    return true;
+  }
+
+  if (InputManager::isReplaying()) {
+    return InputManager::isReplayLevelFinished();
+  }
+
+  return tickCount == mOptions.mTickCount;
+}
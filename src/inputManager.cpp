@@ -2,6 +2,8 @@
 
 #include "inputManager.h"
 #include "core.h"
+#include "inputRecord.h"
+#include "resourceManager.h"
 #include "utils.h"
 
 #include "tinyxml.h"
@@ -72,7 +74,106 @@ sf::Keyboard::Key InputManager::getKey(KEY_TYPE type) {
 }
 
 bool InputManager::isKeyPressed(KEY_TYPE type) {
-  return sf::Keyboard::isKeyPressed(getKey(type));
+  return (getInstance().mKeyMask & toMask(type)) != 0;
+}
+
+void InputManager::startRecording(const std::string &filename) {
+  CHECK(!filename.empty());
+
+  auto &instance = getInstance();
+
+  IS_NULL(instance.mRecord);
+
+  instance.mRecord = makeUnique<InputRecord>();
+  instance.mRecordFile = filename;
+}
+
+void InputManager::stopRecording() {
+  auto &instance = getInstance();
+
+  if (instance.mSource != SOURCE::KEYBOARD || instance.mRecord == nullptr) {
+    return;
+  }
+
+  instance.mRecord->save(instance.mRecordFile);
+  instance.mRecord.reset();
+  instance.mRecordFile.clear();
+}
+
+void InputManager::startReplay(const std::string &filename) {
+  auto &instance = getInstance();
+
+  IS_NULL(instance.mRecord);
+
+  instance.mRecord = makeUnique<InputRecord>();
+  instance.mRecord->load(filename);
+  instance.mSource = SOURCE::REPLAY;
+  instance.mReplaySegment = 0;
+  instance.mReplayTick = 0;
+}
+
+bool InputManager::isReplaying() {
+  return getInstance().mSource == SOURCE::REPLAY;
+}
+
+size_t InputManager::getReplayLevelCount() {
+  CHECK(isReplaying());
+
+  return getInstance().mRecord->getSegmentCount();
+}
+
+size_t InputManager::getReplayLevel(size_t index) {
+  CHECK(isReplaying());
+
+  return getInstance().mRecord->getLevel(index);
+}
+
+bool InputManager::isReplayLevelFinished() {
+  CHECK(isReplaying());
+
+  const auto &instance = getInstance();
+
+  // segments are counted from 1 once the level is started
+  CHECK(instance.mReplaySegment > 0);
+
+  const auto &ticks = instance.mRecord->getTicks(instance.mReplaySegment - 1);
+
+  return instance.mReplayTick == ticks.size();
+}
+
+void InputManager::beginLevel(size_t level) {
+  auto &instance = getInstance();
+
+  instance.mKeyMask = 0;
+
+  if (instance.mRecord == nullptr) {
+    return;
+  }
+
+  if (instance.mSource == SOURCE::REPLAY) {
+    CHECK(instance.mReplaySegment < instance.mRecord->getSegmentCount());
+    CHECK(instance.mRecord->getLevel(instance.mReplaySegment) == level);
+
+    instance.mReplaySegment++;
+    instance.mReplayTick = 0;
+  } else {
+    instance.mRecord->beginLevel(level);
+  }
+}
+
+void InputManager::tick() {
+  auto &instance = getInstance();
+
+  if (instance.mSource == SOURCE::REPLAY) {
+    instance.mKeyMask = instance.nextReplayTick();
+    return;
+  }
+
+  instance.mKeyMask = instance.pollKeyboard();
+
+  if (instance.mRecord != nullptr) {
+    instance.mRecord->push(instance.mKeyMask);
+  }
 }
 
 const InputManager::LayoutMap &InputManager::getLayout(bool isDefault) {
@@ -122,7 +223,45 @@ InputManager &InputManager::getInstance() {
   return *mInstance;
 }
 
-InputManager::InputManager() : mLayoutMap() { parseLayout(); }
+InputManager::InputManager()
+    : mLayoutMap(), mSource(SOURCE::KEYBOARD), mKeyMask(0), mRecord(),
+      mRecordFile(), mReplaySegment(0), mReplayTick(0) {
+  parseLayout();
+}
+
+InputManager::KeyMask InputManager::pollKeyboard() const {
+  // the keyboard can't be polled without a display
+  if (ResourceManager::isHeadless()) {
+    return 0;
+  }
+
+  KeyMask mask = 0;
+
+  for (const auto &layoutPair : mLayoutMap) {
+    if (layoutPair.second != sf::Keyboard::Unknown &&
+        sf::Keyboard::isKeyPressed(layoutPair.second)) {
+      mask |= toMask(layoutPair.first);
+    }
+  }
+
+  return mask;
+}
+
+InputManager::KeyMask InputManager::nextReplayTick() {
+  CHECK(mReplaySegment > 0);
+
+  const auto &ticks = mRecord->getTicks(mReplaySegment - 1);
+
+  CHECK(mReplayTick < ticks.size());
+
+  return ticks[mReplayTick++];
+}
+
+InputManager::KeyMask InputManager::toMask(KEY_TYPE type) {
+  CHECK(type != KEY_TYPE::NONE);
+
+  return static_cast<KeyMask>(1u << static_cast<unsigned int>(type));
+}
 
 void InputManager::parseLayout() {
   TiXmlDocument doc;
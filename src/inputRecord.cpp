@@ -0,0 +1,137 @@
+#define LOG_TAG "InputRecord"
+
+#include "inputRecord.h"
+#include "core.h"
+#include "inputManager.h"
+
+#include <fstream>
+
+namespace {
+// little-endian, independent of the host byte order
+void writeUint(std::ostream &output, std::uint32_t value, size_t byteCount) {
+  for (size_t i = 0; i < byteCount; i++) {
+    output.put(static_cast<char>((value >> (8u * i)) & 0xFFu));
+  }
+}
+
+std::uint32_t readUint(std::istream &input, size_t byteCount) {
+  std::uint32_t value = 0;
+
+  for (size_t i = 0; i < byteCount; i++) {
+    const auto byte = input.get();
+
+    CHECK(byte != std::char_traits<char>::eof());
+
+    value |= static_cast<std::uint32_t>(byte) << (8u * i);
+  }
+
+  return value;
+}
+} // unnamed namespace
+
+// file layout:
+// magic, version, key count, segment count,
+// per segment: level, run count, runs of (key mask, tick count)
+const std::string InputRecord::mMagic = "PFIR";
+const std::uint8_t InputRecord::mVersion = 1u;
+const size_t InputRecord::mMaxRunLength = 0xFFFFu;
+
+InputRecord::InputRecord() : mSegments() {}
+
+void InputRecord::beginLevel(size_t level) {
+  mSegments.push_back(Segment{level, TickVector()});
+}
+
+void InputRecord::push(KeyMask mask) {
+  CHECK(!mSegments.empty());
+
+  mSegments.back().mTicks.push_back(mask);
+}
+
+size_t InputRecord::getSegmentCount() const { return mSegments.size(); }
+
+size_t InputRecord::getLevel(size_t segment) const {
+  CHECK(segment < mSegments.size());
+
+  return mSegments[segment].mLevel;
+}
+
+const InputRecord::TickVector &InputRecord::getTicks(size_t segment) const {
+  CHECK(segment < mSegments.size());
+
+  return mSegments[segment].mTicks;
+}
+
+void InputRecord::save(const std::string &filename) const {
+  CHECK(!filename.empty());
+
+  std::ofstream output(filename, std::ios::binary);
+
+  CHECK(output.is_open());
+
+  output.write(mMagic.data(), mMagic.size());
+  writeUint(output, mVersion, 1u);
+  writeUint(output, static_cast<std::uint32_t>(KEY_TYPE::COUNT), 1u);
+  writeUint(output, mSegments.size(), 4u);
+
+  for (const auto &segment : mSegments) {
+    std::vector<std::pair<KeyMask, size_t>> runs;
+
+    for (const auto mask : segment.mTicks) {
+      if (runs.empty() || runs.back().first != mask ||
+          runs.back().second == mMaxRunLength) {
+        runs.emplace_back(mask, 0u);
+      }
+
+      runs.back().second++;
+    }
+
+    writeUint(output, segment.mLevel, 4u);
+    writeUint(output, runs.size(), 4u);
+
+    for (const auto &run : runs) {
+      writeUint(output, run.first, 1u);
+      writeUint(output, run.second, 2u);
+    }
+  }
+
+  CHECK(output.good());
+
+  LOG("%zu level(s) saved to %s", mSegments.size(), filename.c_str());
+}
+
+void InputRecord::load(const std::string &filename) {
+  CHECK(!filename.empty());
+  CHECK(mSegments.empty());
+
+  std::ifstream input(filename, std::ios::binary);
+
+  CHECK(input.is_open());
+
+  std::string magic(mMagic.size(), '\0');
+  input.read(&magic[0], magic.size());
+
+  CHECK(magic == mMagic);
+  CHECK(readUint(input, 1u) == mVersion);
+  CHECK(readUint(input, 1u) == static_cast<std::uint32_t>(KEY_TYPE::COUNT));
+
+  const size_t segmentCount = readUint(input, 4u);
+
+  for (size_t i = 0; i < segmentCount; i++) {
+    beginLevel(readUint(input, 4u));
+
+    auto &ticks = mSegments.back().mTicks;
+    const size_t runCount = readUint(input, 4u);
+
+    for (size_t j = 0; j < runCount; j++) {
+      const auto mask = static_cast<KeyMask>(readUint(input, 1u));
+      const size_t length = readUint(input, 2u);
+
+      CHECK(length > 0);
+
+      ticks.insert(ticks.end(), length, mask);
+    }
+  }
+
+  CHECK(input.peek() == std::char_traits<char>::eof());
+}
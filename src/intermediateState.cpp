@@ -4,14 +4,12 @@
 #include "componentDefinition.h"
 #include "core.h"
 #include "label.h"
-#include "resourceManager.h"
 #include "stateManager.h"
 #include "stateType.h"
 #include "utils.h"
 
-#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Sprite.hpp>
-#include <SFML/Graphics/Texture.hpp>
 #include <SFML/Window/Event.hpp>
 
 const sf::Color IntermediateState::mBackgroundColor = {0, 0, 0, 150};
@@ -35,8 +33,7 @@ IntermediateState::IntermediateState(StateManager &stateManager)
     : StateBase{stateManager}, mHeaderLabel(),
       mInfoLabel(makeUnique<Label>(mInfoLabelDefinition)),
       mInfoCountdown(mInfoDelay), mShowInfo(true),
-      mBackgroundTexture(makeUnique<sf::Texture>()),
-      mBackgroundSprite(makeUnique<sf::Sprite>()),
+      mBackgroundSprite(makeUnique<sf::Sprite>(stateManager.getSceneTexture())),
       mBackgroundRectangle(makeUnique<sf::RectangleShape>(
           sf::Vector2f{static_cast<float>(WINDOW_WIDTH),
                        static_cast<float>(WINDOW_HEIGHT)})) {
@@ -45,10 +42,6 @@ IntermediateState::IntermediateState(StateManager &stateManager)
       "Level " + std::to_string(stateManager.getCurrentLevel()) + " completed!";
   mHeaderLabel = makeUnique<Label>(headerDefinition);
 
-  CHECK(mBackgroundTexture->create(WINDOW_WIDTH, WINDOW_HEIGHT));
-
-  mBackgroundTexture->update(ResourceManager::getWindow());
-  mBackgroundSprite->setTexture(*mBackgroundTexture);
   mBackgroundRectangle->setFillColor(mBackgroundColor);
 }
 
@@ -0,0 +1,72 @@
+#define LOG_TAG "LaunchOptions"
+
+#include "launchOptions.h"
+#include "core.h"
+#include "utils.h"
+
+namespace {
+const size_t DEFAULT_TICK_COUNT = 60u * FRAMERATE;
+const std::string DEFAULT_PROFILE_FILE = "profile.json";
+
+const char *nextArgument(int argc, const char *const *argv, int &index) {
+  CHECK(index + 1 < argc);
+
+  return argv[++index];
+}
+} // unnamed namespace
+
+LaunchOptions::LaunchOptions()
+    : mHeadless(false), mLevel(0u), mLevelFile(), mTickCount(DEFAULT_TICK_COUNT),
+      mRecordFile(), mReplayFile(), mProfile(false),
+      mProfileFile(DEFAULT_PROFILE_FILE), mPipelined(false),
+      mMemoryBudget(0u) {}
+
+LaunchOptions parseLaunchOptions(int argc, const char *const *argv) {
+  NOT_NULL(argv);
+
+  LaunchOptions options;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+
+    if (argument == "--headless") {
+      options.mHeadless = true;
+    } else if (argument == "--level") {
+      options.mLevel = strToUintSave(nextArgument(argc, argv, i));
+
+      CHECK(options.mLevel > 0);
+    } else if (argument == "--level-file") {
+      options.mLevelFile = nextArgument(argc, argv, i);
+    } else if (argument == "--ticks") {
+      options.mTickCount = strToUintSave(nextArgument(argc, argv, i));
+
+      CHECK(options.mTickCount > 0);
+    } else if (argument == "--record") {
+      options.mRecordFile = nextArgument(argc, argv, i);
+    } else if (argument == "--replay") {
+      options.mReplayFile = nextArgument(argc, argv, i);
+    } else if (argument == "--profile") {
+      options.mProfile = true;
+      options.mProfileFile = nextArgument(argc, argv, i);
+    } else if (argument == "--pipelined") {
+      options.mPipelined = true;
+    } else if (argument == "--memory-budget") {
+      options.mMemoryBudget = strToUintSave(nextArgument(argc, argv, i));
+
+      CHECK(options.mMemoryBudget > 0);
+    } else {
+      LOG("unknown argument: %s", argument.c_str());
+      CHECK(false);
+    }
+  }
+
+  // recording needs the keyboard, replay defines the levels on its own
+  CHECK(options.mRecordFile.empty() || !options.mHeadless);
+  CHECK(options.mReplayFile.empty() ||
+        (options.mHeadless && options.mLevel == 0));
+  CHECK(options.mLevelFile.empty() ||
+        (options.mHeadless && options.mLevel == 0 &&
+         options.mReplayFile.empty()));
+
+  return options;
+}
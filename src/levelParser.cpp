@@ -29,8 +29,10 @@ const LevelParser::NameTypePair LevelParser::mNameTypeMap[] = {
     {"finish", OBJECT_TYPE::FINISH},
 };
 const size_t LevelParser::mNameTypeMapSize = arraySize(mNameTypeMap);
+const std::string LevelParser::mTileCollisionValue = "tiles";
 
-LevelParser::LevelParser(const std::string &filename) : mInfo(), mObjectMap() {
+LevelParser::LevelParser(const std::string &filename)
+    : mInfo(), mTileCollision(false), mObjectMap() {
   CHECK(!filename.empty());
 
   parseFile(filename);
@@ -69,13 +71,19 @@ LevelParser::getObjectsFor(OBJECT_TYPE type) const {
 bool LevelParser::isRequiredType(OBJECT_TYPE type) const {
   CHECK(type != OBJECT_TYPE::NONE);
 
+  if (type == OBJECT_TYPE::SOLID && mTileCollision) {
+    return false;
+  }
+
   return mRequiredObjectTypes.find(type) != mRequiredObjectTypes.cend();
 }
 
+bool LevelParser::hasTileCollision() const { return mTileCollision; }
+
 void LevelParser::parseFile(const std::string &filename) {
   TiXmlDocument doc;
 
-  CHECK(doc.LoadFile(LEVELS_DIR + filename));
+  CHECK(doc.LoadFile(filename));
 
   TiXmlElement *const mapElem = doc.FirstChildElement("map");
 
@@ -93,6 +101,8 @@ void LevelParser::parseFile(const std::string &filename) {
   CHECK(mapRectNum.x > 0 && mapRectNum.y > 0);
   CHECK(tileSize.x > 0 && tileSize.x == tileSize.y);
 
+  mTileCollision = parseTileCollision(mapElem);
+
   TiXmlElement *const tilesetElem = mapElem->FirstChildElement("tileset");
 
   NOT_NULL(tilesetElem);
@@ -125,10 +135,58 @@ void LevelParser::parseFile(const std::string &filename) {
         TIXML_SUCCESS);
   CHECK(textureSize.x > 0 && textureSize.y > 0);
 
-  TiXmlElement *const layerElem = mapElem->FirstChildElement("layer");
+  std::vector<TileLayerInfo> layers;
+
+  for (const TiXmlElement *layerElem = mapElem->FirstChildElement("layer");
+       layerElem != nullptr;
+       layerElem = layerElem->NextSiblingElement("layer")) {
+    layers.push_back(parseLayer(layerElem, mapRectNum));
+  }
+
+  CHECK(!layers.empty());
+
+  mInfo.set(tilesetTextureName, mapRectNum, layers, firstgid, tileSize.x);
+
+  const TiXmlElement *objectgroupElem =
+      mapElem->FirstChildElement("objectgroup");
+
+  NOT_NULL(objectgroupElem);
 
+  for (; objectgroupElem != nullptr;
+       objectgroupElem = objectgroupElem->NextSiblingElement("objectgroup")) {
+    parseObjectGroup(objectgroupElem);
+  }
+
+  for (auto type : mRequiredObjectTypes) {
+    CHECK(hasType(type) || !isRequiredType(type));
+  }
+
+  CHECK(getObjectsFor(OBJECT_TYPE::PLAYER).size() == 1);
+}
+
+TileLayerInfo LevelParser::parseLayer(const TiXmlElement *const layerElem,
+                                      const sf::Vector2u &mapRectNum) const {
   NOT_NULL(layerElem);
 
+  TileLayerInfo layer;
+
+  // Tiled leaves out factors equal to 1
+  layer.mParallax = {1.f, 1.f};
+
+  CHECK(layerElem->QueryValueAttribute("parallaxx", &layer.mParallax.x) !=
+        TIXML_WRONG_TYPE);
+  CHECK(layerElem->QueryValueAttribute("parallaxy", &layer.mParallax.y) !=
+        TIXML_WRONG_TYPE);
+
+  layer.mDepth = 0;
+
+  const TiXmlElement *const depthElem = findProperty(layerElem, "depth");
+
+  if (depthElem != nullptr) {
+    CHECK(depthElem->QueryIntAttribute("value", &layer.mDepth) ==
+          TIXML_SUCCESS);
+  }
+
   const TiXmlElement *const dataElem = layerElem->FirstChildElement("data");
 
   NOT_NULL(dataElem);
@@ -142,14 +200,15 @@ void LevelParser::parseFile(const std::string &filename) {
 
   NOT_NULL(gidStr);
 
-  const std::vector<unsigned int> gids = parseGids(gidStr);
+  layer.mGids = parseGids(gidStr);
 
-  CHECK(static_cast<size_t>(mapRectNum.x * mapRectNum.y) == gids.size());
+  CHECK(static_cast<size_t>(mapRectNum.x * mapRectNum.y) ==
+        layer.mGids.size());
 
-  mInfo.set(tilesetTextureName, mapRectNum, gids, firstgid, tileSize.x);
-  TiXmlElement *const objectgroupElem =
-      mapElem->FirstChildElement("objectgroup");
+  return layer;
+}
 
+void LevelParser::parseObjectGroup(const TiXmlElement *const objectgroupElem) {
   NOT_NULL(objectgroupElem);
 
   for (const TiXmlElement *objectElem =
@@ -185,12 +244,43 @@ void LevelParser::parseFile(const std::string &filename) {
 
     it->second.emplace_back(object);
   }
+}
 
-  for (auto type : mRequiredObjectTypes) {
-    CHECK(hasType(type));
+bool LevelParser::parseTileCollision(const TiXmlElement *const mapElem) const {
+  const TiXmlElement *const propertyElem = findProperty(mapElem, "collision");
+
+  if (propertyElem == nullptr) {
+    return false;
   }
 
-  CHECK(getObjectsFor(OBJECT_TYPE::PLAYER).size() == 1);
+  const char *const value = propertyElem->Attribute("value");
+
+  return value != nullptr && value == mTileCollisionValue;
+}
+
+const TiXmlElement *LevelParser::findProperty(const TiXmlElement *const elem,
+                                              const std::string &name) const {
+  NOT_NULL(elem);
+
+  const TiXmlElement *const propertiesElem =
+      elem->FirstChildElement("properties");
+
+  if (propertiesElem == nullptr) {
+    return nullptr;
+  }
+
+  for (const TiXmlElement *propertyElem =
+           propertiesElem->FirstChildElement("property");
+       propertyElem != nullptr;
+       propertyElem = propertyElem->NextSiblingElement("property")) {
+    const char *const propertyName = propertyElem->Attribute("name");
+
+    if (propertyName != nullptr && name == propertyName) {
+      return propertyElem;
+    }
+  }
+
+  return nullptr;
 }
 
 std::vector<unsigned int>
@@ -229,11 +319,11 @@ OBJECT_TYPE LevelParser::nameToType(const std::string &name) const {
 
 void TileMapInfo::set(const std::string &tilesetTextureName,
                       const sf::Vector2u &mapRectNum,
-                      const std::vector<unsigned int> &gids,
+                      const std::vector<TileLayerInfo> &layers,
                       unsigned int firstgid, unsigned int tileSize) {
   mTilesetTextureName = tilesetTextureName;
   mMapRectNum = mapRectNum;
-  mGids = gids;
+  mLayers = layers;
   mFirstgid = firstgid;
   mTileSize = tileSize;
 }
@@ -0,0 +1,52 @@
+#define LOG_TAG "LoadingState"
+
+#include "loadingState.h"
+#include "assetLoader.h"
+#include "core.h"
+#include "stateManager.h"
+#include "stateType.h"
+#include "utils.h"
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/System/Time.hpp>
+
+const sf::Vector2f LoadingState::mBarSize = {0.5f * WINDOW_WIDTH, 16.f};
+const sf::Color LoadingState::mBarColor = STATE_HEADER_COLOR;
+const sf::Color LoadingState::mFrameColor = {128, 128, 128};
+const float LoadingState::mFrameThickness = 2.f;
+
+LoadingState::LoadingState(StateManager &stateManager)
+    : StateBase{stateManager}, mLoader(makeUnique<AssetLoader>()),
+      mFrame(makeUnique<sf::RectangleShape>(mBarSize)),
+      mBar(makeUnique<sf::RectangleShape>(sf::Vector2f{0.f, mBarSize.y})) {
+  const sf::Vector2f position = {0.5f * (WINDOW_WIDTH - mBarSize.x),
+                                 0.5f * (WINDOW_HEIGHT - mBarSize.y)};
+
+  mFrame->setPosition(position);
+  mFrame->setFillColor(sf::Color::Transparent);
+  mFrame->setOutlineColor(mFrameColor);
+  mFrame->setOutlineThickness(mFrameThickness);
+
+  mBar->setPosition(position);
+  mBar->setFillColor(mBarColor);
+}
+
+LoadingState::~LoadingState() {}
+
+void LoadingState::handleEvent(const sf::Event & /*event*/) {}
+
+void LoadingState::update(sf::Time /*dt*/) {
+  mLoader->update();
+  mBar->setSize({mLoader->getProgress() * mBarSize.x, mBarSize.y});
+
+  if (mLoader->isDone()) {
+    getStateManager().requestStateTranstion(STATE_TYPE::INTRO);
+  }
+}
+
+void LoadingState::draw(sf::RenderTarget &target,
+                        sf::RenderStates states) const {
+  target.draw(*mFrame, states);
+  target.draw(*mBar, states);
+}
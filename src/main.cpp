@@ -0,0 +1,19 @@
+#define LOG_TAG "Main"
+
+#include "application.h"
+#include "core.h"
+#include "headlessRunner.h"
+#include "launchOptions.h"
+#include "utils.h"
+
+int main(int argc, char **argv) {
+  const auto options = parseLaunchOptions(argc, argv);
+
+  if (options.mHeadless) {
+    makeUnique<HeadlessRunner>(options)->run();
+  } else {
+    makeUnique<Application>(options)->run();
+  }
+
+  return 0;
+}
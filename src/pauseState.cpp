@@ -6,15 +6,13 @@
 #include "componentDefinition.h"
 #include "core.h"
 #include "label.h"
-#include "resourceManager.h"
 #include "stateManager.h"
 #include "stateType.h"
 #include "utils.h"
 
 #include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Sprite.hpp>
-#include <SFML/Graphics/Texture.hpp>
 #include <SFML/Window/Event.hpp>
 
 const sf::Color PauseState::mBackgroundColor = {0, 0, 0, 150};
@@ -34,15 +32,10 @@ const ComponentDefinition PauseState::mGoToMenuButtonDefinition{
 PauseState::PauseState(StateManager &stateManager)
     : StateBase{stateManager},
       mHeaderLabel(makeUnique<Label>(mHeaderLabelDefinition)), mButtonView(),
-      mBackgroundTexture(makeUnique<sf::Texture>()),
-      mBackgroundSprite(makeUnique<sf::Sprite>()),
+      mBackgroundSprite(makeUnique<sf::Sprite>(stateManager.getSceneTexture())),
       mBackgroundRectangle(makeUnique<sf::RectangleShape>(
           sf::Vector2f{static_cast<float>(WINDOW_WIDTH),
                        static_cast<float>(WINDOW_HEIGHT)})) {
-  CHECK(mBackgroundTexture->create(WINDOW_WIDTH, WINDOW_HEIGHT));
-
-  mBackgroundTexture->update(ResourceManager::getWindow());
-  mBackgroundSprite->setTexture(*mBackgroundTexture);
   mBackgroundRectangle->setFillColor(mBackgroundColor);
 
   ButtonView::ButtonList buttons;
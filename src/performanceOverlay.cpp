@@ -0,0 +1,164 @@
+#define LOG_TAG "PerformanceOverlay"
+
+#include "performanceOverlay.h"
+#include "bulletPool.h"
+#include "core.h"
+#include "physicalWorld.h"
+#include "resourceManager.h"
+#include "soundPlayer.h"
+#include "utils.h"
+#include "world.h"
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Text.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+const size_t PerformanceOverlay::mHistorySize = 120u;
+const size_t PerformanceOverlay::mTextRefreshFrames = 15u;
+const float PerformanceOverlay::mPixelsPerMillisecond = 2.f;
+const float PerformanceOverlay::mMaxGraphMilliseconds = 50.f;
+const sf::Vector2f PerformanceOverlay::mPosition = {10.f, 10.f};
+const std::string PerformanceOverlay::mFontName = "KaushanScript-Regular.otf";
+const unsigned int PerformanceOverlay::mCharacterSize = 14u;
+
+PerformanceOverlay::PerformanceOverlay()
+    : mVisible(false), mHistory(), mFramesSinceRefresh(0),
+      mGraph(sf::Quads), mText(makeUnique<sf::Text>()) {
+  mText->setFont(ResourceManager::getFont(mFontName));
+  mText->setCharacterSize(mCharacterSize);
+  mText->setFillColor(sf::Color::White);
+  // below the graph
+  mText->setPosition(mPosition.x, 2.f * mPosition.y + mMaxGraphMilliseconds *
+                                                          mPixelsPerMillisecond);
+}
+
+PerformanceOverlay::~PerformanceOverlay() {}
+
+void PerformanceOverlay::toggle() { mVisible = !mVisible; }
+
+bool PerformanceOverlay::isVisible() const { return mVisible; }
+
+void PerformanceOverlay::addFrame(sf::Time frameTime, sf::Time tickTime,
+                                  sf::Time renderTime, const World *world) {
+  mHistory.push_back({frameTime, tickTime, renderTime});
+
+  if (mHistory.size() > mHistorySize) {
+    mHistory.pop_front();
+  }
+
+  // nothing is shown, keep only the history
+  if (!mVisible) {
+    return;
+  }
+
+  updateGraph();
+
+  if (++mFramesSinceRefresh >= mTextRefreshFrames) {
+    mFramesSinceRefresh = 0;
+    updateText(world);
+  }
+}
+
+void PerformanceOverlay::updateGraph() {
+  const auto budget = 1000.f / FRAMERATE;
+  const auto baseY = mPosition.y + mMaxGraphMilliseconds * mPixelsPerMillisecond;
+
+  mGraph.clear();
+
+  float x = mPosition.x;
+
+  for (const auto &times : mHistory) {
+    const auto ms = times.mFrame.asSeconds() * 1000.f;
+    const auto height =
+        std::min(ms, mMaxGraphMilliseconds) * mPixelsPerMillisecond;
+    const auto color = ms <= budget          ? sf::Color::Green
+                       : ms <= 2.f * budget ? sf::Color::Yellow
+                                            : sf::Color::Red;
+
+    mGraph.append({{x, baseY - height}, color});
+    mGraph.append({{x + 1.f, baseY - height}, color});
+    mGraph.append({{x + 1.f, baseY}, color});
+    mGraph.append({{x, baseY}, color});
+
+    x += 1.f;
+  }
+
+  // budget of one tick
+  const auto budgetY = baseY - budget * mPixelsPerMillisecond;
+  const auto right = mPosition.x + mHistorySize;
+
+  mGraph.append({{mPosition.x, budgetY}, sf::Color::White});
+  mGraph.append({{right, budgetY}, sf::Color::White});
+  mGraph.append({{right, budgetY + 1.f}, sf::Color::White});
+  mGraph.append({{mPosition.x, budgetY + 1.f}, sf::Color::White});
+}
+
+void PerformanceOverlay::updateText(const World *world) {
+  FrameTimes sum = {};
+
+  for (const auto &times : mHistory) {
+    sum.mFrame += times.mFrame;
+    sum.mTick += times.mTick;
+    sum.mRender += times.mRender;
+  }
+
+  const auto count = static_cast<float>(std::max<size_t>(mHistory.size(), 1u));
+  const auto frameMs = sum.mFrame.asSeconds() * 1000.f / count;
+
+  char buffer[256];
+  int length = std::snprintf(
+      buffer, sizeof(buffer),
+      "frame %.2f ms (%.0f fps)\ntick %.2f ms\nrender %.2f ms\nvoices %zu",
+      frameMs, frameMs > 0.f ? 1000.f / frameMs : 0.f,
+      sum.mTick.asSeconds() * 1000.f / count,
+      sum.mRender.asSeconds() * 1000.f / count,
+      SoundPlayer::getVoiceCount());
+
+  CHECK(length > 0 && static_cast<size_t>(length) < sizeof(buffer));
+
+  std::string str = buffer;
+
+  if (world != nullptr) {
+    const auto &physicalWorld = world->getPhysicalWorld();
+    const auto &bulletPool = world->getBulletPool();
+
+    length = std::snprintf(
+        buffer, sizeof(buffer),
+        "\nentities %zu (%zu simulated, %zu drawn)\nbodies %zu\n"
+        "contacts %zu\nproxies %zu\nbullet pool %zu hits, %zu misses",
+        world->getEntityCount(), world->getSimulatedEntityCount(),
+        world->getDrawnEntityCount(), physicalWorld.getBodyCount(),
+        physicalWorld.getContactCount(), physicalWorld.getProxyCount(),
+        bulletPool.getHitCount(), bulletPool.getMissCount());
+
+    CHECK(length > 0 && static_cast<size_t>(length) < sizeof(buffer));
+
+    str += buffer;
+  }
+
+  mText->setString(str);
+}
+
+void PerformanceOverlay::draw(sf::RenderTarget &target,
+                              sf::RenderStates states) const {
+  if (!mVisible) {
+    return;
+  }
+
+  const auto textBounds = mText->getGlobalBounds();
+
+  sf::RectangleShape background;
+  background.setPosition(mPosition / 2.f);
+  background.setSize(
+      {std::max(static_cast<float>(mHistorySize), textBounds.width) +
+           mPosition.x,
+       textBounds.top + textBounds.height});
+  background.setFillColor({0u, 0u, 0u, 160u});
+
+  target.draw(background, states);
+  target.draw(mGraph, states);
+  target.draw(*mText, states);
+}
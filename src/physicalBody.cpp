@@ -36,3 +36,7 @@ const sf::FloatRect &PhysicalBody::getBounds() const { return mBounds; }
 OBJECT_TYPE PhysicalBody::getType() const { return mType; }
 
 b2Body &PhysicalBody::getBody() const { return *mBody; }
+
+const PhysicalWorld &PhysicalBody::getPhysicalWorld() const {
+  return mPhysicalWorld;
+}
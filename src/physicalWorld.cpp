@@ -3,10 +3,13 @@
 #include "physicalWorld.h"
 #include "core.h"
 #include "entity.h"
+#include "fixtureData.h"
+#include "geometryBaker.h"
 #include "levelParser.h"
 #include "objectType.h"
 #include "physicalBody.h"
 #include "player.h"
+#include "profiler.h"
 #include "soundPlayer.h"
 #include "utils.h"
 
@@ -83,31 +86,18 @@ bool isGround(OBJECT_TYPE type) {
          type == OBJECT_TYPE::SOLID_ON_LADDER;
 }
 
-bool findFixtureType(b2Contact *const contact, OBJECT_TYPE wantedType,
-                     const b2Fixture **const wanted,
-                     const b2Fixture **const other) {
-  NOT_NULL(contact);
-  CHECK(wantedType != OBJECT_TYPE::NONE);
-  NOT_NULL(wanted);
-  NOT_NULL(other);
-
-  const auto fixtureA = contact->GetFixtureA();
-  const auto fixtureB = contact->GetFixtureB();
-
-  const auto typeA = getFixtureUserData(fixtureA)->getType();
-  const auto typeB = getFixtureUserData(fixtureB)->getType();
-
-  if (typeA == wantedType) {
-    *wanted = fixtureA;
-    *other = fixtureB;
-    return true;
-  } else if (typeB == wantedType) {
-    *wanted = fixtureB;
-    *other = fixtureA;
-    return true;
+// adds the shape to the baker unless it has to keep its own body
+bool bakeShape(GeometryBaker &baker, OBJECT_TYPE type,
+               const sf::FloatRect &object) {
+  switch (type) {
+  case OBJECT_TYPE::SOLID:
+    return baker.addRectangle(object);
+  case OBJECT_TYPE::SLOPE_LEFT:
+  case OBJECT_TYPE::SLOPE_RIGHT:
+    return baker.addSlope(object, type == OBJECT_TYPE::SLOPE_LEFT);
+  default:
+    return false;
   }
-
-  return false;
 }
 
 bool isSensor(OBJECT_TYPE type) {
@@ -128,71 +118,297 @@ bool findColliderType(OBJECT_TYPE typeA, OBJECT_TYPE typeB,
   return false;
 }
 
-bool shouldCollideWithPlayer(OBJECT_TYPE type) {
-  CHECK(type != OBJECT_TYPE::NONE);
-  // should not collide with itself
-  CHECK(type != OBJECT_TYPE::PLAYER);
+bool shouldCollide(OBJECT_TYPE typeA, OBJECT_TYPE typeB) {
+  if (typeA == OBJECT_TYPE::NONE || typeB == OBJECT_TYPE::NONE) {
+    return false;
+  }
 
-  switch (type) {
-  case OBJECT_TYPE::ARCHER:
-  case OBJECT_TYPE::RUNNER:
-  case OBJECT_TYPE::ENEMY_BULLET:
-  case OBJECT_TYPE::EXPLODED_BULLET:
-  case OBJECT_TYPE::LADDER:
-  case OBJECT_TYPE::FINISH:
-  case OBJECT_TYPE::HAZARD:
+  if (isGround(typeA) || isGround(typeB)) {
     return true;
+  }
+
+  auto otherType = OBJECT_TYPE::NONE;
+
+  if (findColliderType(typeA, typeB, OBJECT_TYPE::PLAYER, otherType)) {
+    switch (otherType) {
+      // used only in PreSolve
+    case OBJECT_TYPE::ARCHER:
+    case OBJECT_TYPE::RUNNER:
+    case OBJECT_TYPE::ENEMY_BULLET:
+    // used only in BeginContact
+    case OBJECT_TYPE::FINISH:
+    case OBJECT_TYPE::HAZARD:
+    // used in BeginContact/EndContact
+    case OBJECT_TYPE::LADDER:
+      return true;
+    default:
+      return false;
+    }
+  } else if (findColliderType(typeA, typeB, OBJECT_TYPE::ALLIED_BULLET,
+                              otherType)) {
+    return isEnemy(otherType);
+  }
+
+  return false;
+}
+
+// handler of a contact, named after the first type of the pair
+enum class CONTACT_KIND {
+  NONE,
+  SENSOR_ON_GROUND,
+  PLAYER_ON_LADDER,
+  PLAYER_ON_SOLID_ON_LADDER,
+  PLAYER_IN_HAZARD,
+  PLAYER_AT_FINISH,
+  PLAYER_HIT_ENEMY,
+  ENEMY_BULLET_HIT,
+  ALLIED_BULLET_HIT
+};
+
+CONTACT_KIND getOrderedContactKind(OBJECT_TYPE first, OBJECT_TYPE second) {
+  switch (first) {
+  case OBJECT_TYPE::PLAYER_SENSOR:
+    return isGround(second) ? CONTACT_KIND::SENSOR_ON_GROUND
+                            : CONTACT_KIND::NONE;
+  case OBJECT_TYPE::PLAYER:
+    switch (second) {
+    case OBJECT_TYPE::LADDER:
+      return CONTACT_KIND::PLAYER_ON_LADDER;
+    case OBJECT_TYPE::SOLID_ON_LADDER:
+      return CONTACT_KIND::PLAYER_ON_SOLID_ON_LADDER;
+    case OBJECT_TYPE::HAZARD:
+      return CONTACT_KIND::PLAYER_IN_HAZARD;
+    case OBJECT_TYPE::FINISH:
+      return CONTACT_KIND::PLAYER_AT_FINISH;
+    case OBJECT_TYPE::ARCHER:
+    case OBJECT_TYPE::RUNNER:
+      return CONTACT_KIND::PLAYER_HIT_ENEMY;
+    default:
+      return CONTACT_KIND::NONE;
+    }
+  case OBJECT_TYPE::ENEMY_BULLET:
+    return second == OBJECT_TYPE::PLAYER || isGround(second)
+               ? CONTACT_KIND::ENEMY_BULLET_HIT
+               : CONTACT_KIND::NONE;
+  case OBJECT_TYPE::ALLIED_BULLET:
+    return isEnemy(second) || isGround(second) ? CONTACT_KIND::ALLIED_BULLET_HIT
+                                               : CONTACT_KIND::NONE;
   default:
-    return false;
+    return CONTACT_KIND::NONE;
   }
 }
-} // unnamed namespace
 
-const int32 PhysicalWorld::mVelocityIterations = 8;
-const int32 PhysicalWorld::mPositionIterations = 3;
+struct ContactRule {
+  bool mCollide;
 
-const float PhysicalWorld::mSolidOnLadderHeight = 5.f;
+  // fixture B is the first one of the handler
+  bool mSwapped;
 
-class PhysicalWorld::CustomContactFilter : public b2ContactFilter,
-                                           private sf::NonCopyable {
-public:
-  bool ShouldCollide(b2Fixture *fixtureA, b2Fixture *fixtureB) final {
-    const auto typeA = getFixtureUserData(fixtureA)->getType();
-    const auto typeB = getFixtureUserData(fixtureB)->getType();
+  CONTACT_KIND mKind;
+};
 
-    CHECK(typeA != OBJECT_TYPE::NONE);
-    CHECK(typeB != OBJECT_TYPE::NONE);
+const size_t TYPE_COUNT = static_cast<size_t>(OBJECT_TYPE::COUNT);
 
-    if (isGround(typeA) || isGround(typeB)) {
-      return true;
+struct ContactRuleTable {
+  ContactRule mRules[TYPE_COUNT][TYPE_COUNT];
+};
+
+ContactRuleTable createContactRuleTable() {
+  ContactRuleTable table;
+
+  for (size_t a = 0; a < TYPE_COUNT; a++) {
+    for (size_t b = 0; b < TYPE_COUNT; b++) {
+      const auto typeA = static_cast<OBJECT_TYPE>(a);
+      const auto typeB = static_cast<OBJECT_TYPE>(b);
+
+      ContactRule &rule = table.mRules[a][b];
+      rule.mCollide = shouldCollide(typeA, typeB);
+      rule.mSwapped = false;
+      rule.mKind = getOrderedContactKind(typeA, typeB);
+
+      if (rule.mKind == CONTACT_KIND::NONE) {
+        rule.mSwapped = true;
+        rule.mKind = getOrderedContactKind(typeB, typeA);
+      }
+
+      CHECK(rule.mKind == CONTACT_KIND::NONE || rule.mCollide);
     }
+  }
 
-    auto otherType = OBJECT_TYPE::NONE;
+  return table;
+}
 
-    if (findColliderType(typeA, typeB, OBJECT_TYPE::PLAYER, otherType)) {
-      switch (otherType) {
-        // used only in PreSolve
-      case OBJECT_TYPE::ARCHER:
-      case OBJECT_TYPE::RUNNER:
-      case OBJECT_TYPE::ENEMY_BULLET:
-      // used only in BeginContact
-      case OBJECT_TYPE::FINISH:
-      case OBJECT_TYPE::HAZARD:
-      // used in BeginContact/EndContact
-      case OBJECT_TYPE::LADDER:
-        return true;
-      default:
-        return false;
+// filled once, contact callbacks only index it
+const ContactRuleTable CONTACT_RULE_TABLE = createContactRuleTable();
+
+const ContactRule &getContactRule(OBJECT_TYPE typeA, OBJECT_TYPE typeB) {
+  return CONTACT_RULE_TABLE.mRules[static_cast<size_t>(typeA)]
+                                  [static_cast<size_t>(typeB)];
+}
+
+// Box2D has 16 category bits for 17 types, so types whose collisions are
+// identical share a category; masks are exact either way
+const size_t MAX_CATEGORY_COUNT = 16u;
+
+struct CollisionFilterTable {
+  b2Filter mFilters[TYPE_COUNT];
+};
+
+bool haveSameCollisions(size_t typeA, size_t typeB) {
+  for (size_t other = 0; other < TYPE_COUNT; other++) {
+    if (CONTACT_RULE_TABLE.mRules[typeA][other].mCollide !=
+        CONTACT_RULE_TABLE.mRules[typeB][other].mCollide) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+CollisionFilterTable createCollisionFilterTable() {
+  size_t categories[TYPE_COUNT];
+  size_t categoryCount = 0;
+
+  for (size_t type = 0; type < TYPE_COUNT; type++) {
+    size_t sameType = 0;
+
+    while (sameType < type && !haveSameCollisions(type, sameType)) {
+      sameType++;
+    }
+
+    categories[type] = sameType < type ? categories[sameType] : categoryCount++;
+  }
+
+  CHECK(categoryCount <= MAX_CATEGORY_COUNT);
+
+  CollisionFilterTable table;
+
+  for (size_t type = 0; type < TYPE_COUNT; type++) {
+    b2Filter &filter = table.mFilters[type];
+    filter.categoryBits = static_cast<uint16>(1u << categories[type]);
+    filter.maskBits = 0u;
+
+    for (size_t other = 0; other < TYPE_COUNT; other++) {
+      if (CONTACT_RULE_TABLE.mRules[type][other].mCollide) {
+        filter.maskBits |= static_cast<uint16>(1u << categories[other]);
       }
-    } else if (findColliderType(typeA, typeB, OBJECT_TYPE::ALLIED_BULLET,
-                                otherType)) {
-      return isEnemy(otherType);
     }
+  }
 
-    return false;
+  return table;
+}
+
+// lets the broadphase drop pairs before a contact is created
+const CollisionFilterTable COLLISION_FILTER_TABLE =
+    createCollisionFilterTable();
+
+const b2Filter &getCollisionFilter(OBJECT_TYPE type) {
+  CHECK(type != OBJECT_TYPE::NONE);
+
+  return COLLISION_FILTER_TABLE.mFilters[static_cast<size_t>(type)];
+}
+
+CONTACT_KIND findContactKind(b2Contact *const contact,
+                             const b2Fixture **const wanted,
+                             const b2Fixture **const other) {
+  NOT_NULL(contact);
+  NOT_NULL(wanted);
+  NOT_NULL(other);
+
+  const auto fixtureA = contact->GetFixtureA();
+  const auto fixtureB = contact->GetFixtureB();
+
+  const auto &rule =
+      getContactRule(getFixtureUserData(fixtureA)->getType(),
+                     getFixtureUserData(fixtureB)->getType());
+
+  // a bullet turns into EXPLODED_BULLET while it still touches its target,
+  // and the contacts of its deactivated body end with the new type
+  if (!rule.mCollide) {
+    return CONTACT_KIND::NONE;
   }
+
+  *wanted = rule.mSwapped ? fixtureB : fixtureA;
+  *other = rule.mSwapped ? fixtureA : fixtureB;
+
+  return rule.mKind;
+}
+
+bool hasMaskedType(const b2Fixture *const fixture,
+                   PhysicalWorld::TypeMask mask) {
+  return (PhysicalWorld::getTypeMask(getFixtureUserData(fixture)->getType()) &
+          mask) != 0u;
+}
+
+class AreaQueryCallback : public b2QueryCallback, private sf::NonCopyable {
+public:
+  explicit AreaQueryCallback(const b2AABB &area, PhysicalWorld::TypeMask mask,
+                             std::vector<sf::Vector2f> &positions)
+      : mArea(area), mMask(mask), mPositions(positions) {}
+
+  bool ReportFixture(b2Fixture *fixture) final {
+    // the tree holds enlarged boxes, the fixture one is exact
+    if (hasMaskedType(fixture, mMask) &&
+        b2TestOverlap(fixture->GetAABB(0), mArea)) {
+      const b2Vec2 &position = fixture->GetBody()->GetPosition();
+
+      mPositions.push_back(toSFMLCoords(sf::Vector2f{position.x, position.y}));
+    }
+
+    return true;
+  }
+
+private:
+  const b2AABB &mArea;
+  const PhysicalWorld::TypeMask mMask;
+  std::vector<sf::Vector2f> &mPositions;
 };
 
+class ClosestRayCastCallback : public b2RayCastCallback,
+                               private sf::NonCopyable {
+public:
+  explicit ClosestRayCastCallback(PhysicalWorld::TypeMask mask)
+      : mMask(mask), mHit(false), mHitFixture(nullptr), mHitPoint() {}
+
+  float32 ReportFixture(b2Fixture *fixture, const b2Vec2 &point,
+                        const b2Vec2 & /*normal*/, float32 fraction) final {
+    if (!hasMaskedType(fixture, mMask)) {
+      return -1.f;
+    }
+
+    mHit = true;
+    mHitFixture = fixture;
+    mHitPoint = point;
+
+    // the rest of the segment is clipped
+    return fraction;
+  }
+
+  bool getHit(PhysicalWorld::RayHit &hit) const {
+    if (!mHit) {
+      return false;
+    }
+
+    hit.mType = getFixtureUserData(mHitFixture)->getType();
+    hit.mPoint = toSFMLCoords(sf::Vector2f{mHitPoint.x, mHitPoint.y});
+
+    return true;
+  }
+
+private:
+  const PhysicalWorld::TypeMask mMask;
+
+  bool mHit;
+  const b2Fixture *mHitFixture;
+  b2Vec2 mHitPoint;
+};
+} // unnamed namespace
+
+const int32 PhysicalWorld::mVelocityIterations = 8;
+const int32 PhysicalWorld::mPositionIterations = 3;
+
+const float PhysicalWorld::mSolidOnLadderHeight = 5.f;
+
 class PhysicalWorld::CustomContactListener : public b2ContactListener,
                                              private sf::NonCopyable {
 public:
@@ -216,56 +432,39 @@ public:
     const b2Fixture *wanted = nullptr;
     const b2Fixture *other = nullptr;
 
-    if (findFixtureType(contact, OBJECT_TYPE::PLAYER_SENSOR, &wanted, &other)) {
-      const auto otherType = getFixtureUserData(other)->getType();
-
-      CHECK(isGround(otherType));
-
+    switch (findContactKind(contact, &wanted, &other)) {
+    case CONTACT_KIND::SENSOR_ON_GROUND: {
       mPlayerContactNum++;
+      setPlayerParentBody(wanted, other, other->GetBody());
+      break;
+    }
+    case CONTACT_KIND::PLAYER_ON_LADDER: {
+      mLadderListener.onLadderCollision(true, other);
+      break;
+    }
+    case CONTACT_KIND::PLAYER_ON_SOLID_ON_LADDER: {
+      mLadderListener.onSolidCollision(true);
+      break;
+    }
+    case CONTACT_KIND::PLAYER_IN_HAZARD: {
+      Entity *const player = getFixtureUserData(wanted)->getEntity();
 
-      if (isPlatform(otherType)) {
-        const b2Fixture *const playerFixture = wanted->GetNext();
-
-        NOT_NULL(playerFixture);
-
-        Player *const player = dynamic_cast<Player *>(
-            getFixtureUserData(playerFixture)->getEntity());
-        player->setParentBody(other->GetBody());
-      }
-    } else if (findFixtureType(contact, OBJECT_TYPE::PLAYER, &wanted, &other)) {
-      const auto otherType = getFixtureUserData(other)->getType();
-
-      switch (otherType) {
-      case OBJECT_TYPE::LADDER: {
-        mLadderListener.onLadderCollision(true, other);
-        break;
-      }
-      case OBJECT_TYPE::SOLID_ON_LADDER: {
-        mLadderListener.onSolidCollision(true);
-        break;
-      }
-      case OBJECT_TYPE::HAZARD: {
-        Entity *const player = getFixtureUserData(wanted)->getEntity();
-
-        if (!player->isKilled()) {
-          player->kill();
-        }
-
-        break;
+      if (!player->isKilled()) {
+        player->kill();
       }
-      case OBJECT_TYPE::FINISH: {
-        mFinished = true;
 
-        Entity *const player = getFixtureUserData(wanted)->getEntity();
-        SoundPlayer::play("Finish.wav", toSFMLCoords(player->getPosition()));
-        break;
-      }
-      default: {
-        CHECK(shouldCollideWithPlayer(otherType) || isGround(otherType));
+      break;
+    }
+    case CONTACT_KIND::PLAYER_AT_FINISH: {
+      mFinished = true;
 
-        break;
-      }
-      }
+      Entity *const player = getFixtureUserData(wanted)->getEntity();
+      SoundPlayer::play("Finish.wav", toSFMLCoords(player->getPosition()));
+      break;
+    }
+    default: {
+      break;
+    }
     }
   }
 
@@ -273,40 +472,23 @@ public:
     const b2Fixture *wanted = nullptr;
     const b2Fixture *other = nullptr;
 
-    if (findFixtureType(contact, OBJECT_TYPE::PLAYER_SENSOR, &wanted, &other)) {
-      const auto otherType = getFixtureUserData(other)->getType();
-
-      CHECK(isGround(otherType));
-
+    switch (findContactKind(contact, &wanted, &other)) {
+    case CONTACT_KIND::SENSOR_ON_GROUND: {
       mPlayerContactNum--;
-
-      if (isPlatform(otherType)) {
-        const b2Fixture *const playerFixture = wanted->GetNext();
-
-        NOT_NULL(playerFixture);
-
-        Player *const player = dynamic_cast<Player *>(
-            getFixtureUserData(playerFixture)->getEntity());
-        player->setParentBody(nullptr);
-      }
-    } else if (findFixtureType(contact, OBJECT_TYPE::PLAYER, &wanted, &other)) {
-      const OBJECT_TYPE otherType = getFixtureUserData(other)->getType();
-
-      switch (otherType) {
-      case OBJECT_TYPE::LADDER: {
-        mLadderListener.onLadderCollision(false, other);
-        break;
-      }
-      case OBJECT_TYPE::SOLID_ON_LADDER: {
-        mLadderListener.onSolidCollision(false);
-        break;
-      }
-      default: {
-        CHECK(shouldCollideWithPlayer(otherType) || isGround(otherType));
-
-        break;
-      }
-      }
+      setPlayerParentBody(wanted, other, nullptr);
+      break;
+    }
+    case CONTACT_KIND::PLAYER_ON_LADDER: {
+      mLadderListener.onLadderCollision(false, other);
+      break;
+    }
+    case CONTACT_KIND::PLAYER_ON_SOLID_ON_LADDER: {
+      mLadderListener.onSolidCollision(false);
+      break;
+    }
+    default: {
+      break;
+    }
     }
   }
 
@@ -315,71 +497,49 @@ public:
     const b2Fixture *wanted = nullptr;
     const b2Fixture *other = nullptr;
 
-    if (findFixtureType(contact, OBJECT_TYPE::ENEMY_BULLET, &wanted, &other)) {
+    switch (findContactKind(contact, &wanted, &other)) {
+    case CONTACT_KIND::ENEMY_BULLET_HIT: {
       const UserData *const otherUserData = getFixtureUserData(other);
-      const auto otherType = otherUserData->getType();
 
-      if (otherType == OBJECT_TYPE::PLAYER) {
+      if (otherUserData->getType() == OBJECT_TYPE::PLAYER) {
         Entity *const player = otherUserData->getEntity();
 
         if (!player->isKilled()) {
           player->damage(1);
         }
-      } else {
-        CHECK(isGround(otherType));
-      }
-
-      Entity *const enemyBullet = getFixtureUserData(wanted)->getEntity();
-
-      if (!enemyBullet->isKilled()) {
-        enemyBullet->kill();
       }
 
+      killBullet(wanted);
       contact->SetEnabled(false);
-    } else if (findFixtureType(contact, OBJECT_TYPE::PLAYER, &wanted, &other)) {
-      const auto otherType = getFixtureUserData(other)->getType();
-
-      CHECK(shouldCollideWithPlayer(otherType) || isGround(otherType));
-
-      if (isEnemy(otherType)) {
-        const auto enemyPos = other->GetBody()->GetPosition();
-        const auto playerPos = wanted->GetBody()->GetPosition();
-        const auto side = playerPos.x < enemyPos.x
-                              ? Player::COLLISION_SIDE::RIGHT
-                              : Player::COLLISION_SIDE::LEFT;
+      break;
+    }
+    case CONTACT_KIND::PLAYER_HIT_ENEMY: {
+      const auto enemyPos = other->GetBody()->GetPosition();
+      const auto playerPos = wanted->GetBody()->GetPosition();
+      const auto side = playerPos.x < enemyPos.x
+                            ? Player::COLLISION_SIDE::RIGHT
+                            : Player::COLLISION_SIDE::LEFT;
 
-        Player *const player =
-            dynamic_cast<Player *>(getFixtureUserData(wanted)->getEntity());
-        player->onCollisionWithEnemy(side, 1);
+      getPlayer(wanted)->onCollisionWithEnemy(side, 1);
 
-        contact->SetEnabled(false);
-      }
-    } else if (findFixtureType(contact, OBJECT_TYPE::ALLIED_BULLET, &wanted,
-                               &other)) {
-      const auto otherUserData = getFixtureUserData(other);
-      const auto otherType = otherUserData->getType();
+      contact->SetEnabled(false);
+      break;
+    }
+    case CONTACT_KIND::ALLIED_BULLET_HIT: {
+      const UserData *const otherUserData = getFixtureUserData(other);
 
-      if (isEnemy(otherType)) {
+      if (isEnemy(otherUserData->getType())) {
         Entity *const enemy = otherUserData->getEntity();
         enemy->damage(1);
-      } else {
-        CHECK(isGround(otherType));
-      }
-
-      Entity *const alliedBullet = getFixtureUserData(wanted)->getEntity();
-
-      if (!alliedBullet->isKilled()) {
-        alliedBullet->kill();
       }
 
+      killBullet(wanted);
       contact->SetEnabled(false);
-    } else {
-      const auto typeA =
-          (getFixtureUserData(contact->GetFixtureA()))->getType();
-      const auto typeB =
-          (getFixtureUserData(contact->GetFixtureB()))->getType();
-
-      CHECK(isGround(typeA) || isGround(typeB));
+      break;
+    }
+    default: {
+      break;
+    }
     }
   }
 
@@ -427,6 +587,34 @@ private:
     bool mWasOnLadder;
   };
 
+  // the type of the fixture is checked by the contact rule table
+  static Player *getPlayer(const b2Fixture *const playerFixture) {
+    return static_cast<Player *>(
+        getFixtureUserData(playerFixture)->getEntity());
+  }
+
+  static void setPlayerParentBody(const b2Fixture *const sensor,
+                                  const b2Fixture *const ground,
+                                  const b2Body *const parentBody) {
+    if (!isPlatform(getFixtureUserData(ground)->getType())) {
+      return;
+    }
+
+    const b2Fixture *const playerFixture = sensor->GetNext();
+
+    NOT_NULL(playerFixture);
+
+    getPlayer(playerFixture)->setParentBody(parentBody);
+  }
+
+  static void killBullet(const b2Fixture *const bulletFixture) {
+    Entity *const bullet = getFixtureUserData(bulletFixture)->getEntity();
+
+    if (!bullet->isKilled()) {
+      bullet->kill();
+    }
+  }
+
   int mPlayerContactNum;
   LadderListener mLadderListener;
   bool mFinished;
@@ -435,15 +623,15 @@ private:
 PhysicalWorld::PhysicalWorld(const LevelParser &levelParser,
                              PhysicalBodyMap &bodyMap)
     : mContactListener(makeUnique<CustomContactListener>()),
-      mContactFilter(makeUnique<CustomContactFilter>()),
       mWorld(makeUnique<b2World>(b2Vec2{0.f, GRAVITY})),
-      mNonEntityUserDataArray(), mFixtureSizeMap(), mLadderSolidMap(),
-      mPlayerSensorOffset(), mPlayerCallback(nullptr), mVertices(sf::Lines) {
+      mFixtureData(), mFreeFixtureData(), mPlayerSensorOffset(),
+      mPlayerCallback(nullptr), mStaticVertices(sf::Lines),
+      mDynamicVertices(sf::Lines) {
   mWorld->SetContactListener(mContactListener.get());
-  mWorld->SetContactFilter(mContactFilter.get());
 
   initEntityBodies(levelParser, bodyMap);
   initNonEntityBodies(levelParser);
+  bakeStaticDrawing();
 }
 
 PhysicalWorld::~PhysicalWorld() {}
@@ -481,11 +669,12 @@ b2Body *PhysicalWorld::createBody(const sf::FloatRect &object,
   fixtureDef.shape = &polygon;
   fixtureDef.isSensor = isSensor(type);
   fixtureDef.friction = 0.f;
+  fixtureDef.filter = getCollisionFilter(type);
 
-  b2Body *const body = mWorld->CreateBody(&bodyDef);
-  const b2Fixture *const fixture = body->CreateFixture(&fixtureDef);
+  fixtureDef.userData = allocateFixtureData(type, sizeInPixels);
 
-  CHECK(mFixtureSizeMap.emplace(fixture, sizeInPixels).second);
+  b2Body *const body = mWorld->CreateBody(&bodyDef);
+  body->CreateFixture(&fixtureDef);
 
   return body;
 }
@@ -510,10 +699,11 @@ void PhysicalWorld::createFootSensorFor(b2Body *const body,
   fixtureDef.shape = &polygon;
   fixtureDef.isSensor = true;
   fixtureDef.friction = 0.f;
+  fixtureDef.filter = getCollisionFilter(OBJECT_TYPE::PLAYER_SENSOR);
+  fixtureDef.userData =
+      allocateFixtureData(OBJECT_TYPE::PLAYER_SENSOR, sensorSizeInPixels);
 
-  const b2Fixture *const fixture = body->CreateFixture(&fixtureDef);
-
-  CHECK(mFixtureSizeMap.emplace(fixture, sensorSizeInPixels).second);
+  body->CreateFixture(&fixtureDef);
 
   mPlayerSensorOffset = {sensorCenter.x, sensorCenter.y};
 }
@@ -523,30 +713,19 @@ void PhysicalWorld::destroyBody(b2Body *const body) {
 
   for (const b2Fixture *fixture = body->GetFixtureList(); fixture != nullptr;
        fixture = fixture->GetNext()) {
-    CHECK(mFixtureSizeMap.erase(fixture) == 1);
-
-    auto userData = getFixtureUserData(fixture);
-
-    if (!userData->isExtended() &&
-        userData->getType() != OBJECT_TYPE::PLAYER_SENSOR) {
-      const auto it = std::find_if(
-          mNonEntityUserDataArray.begin(), mNonEntityUserDataArray.end(),
-          [userData](const std::unique_ptr<UserData> &p) {
-            return p.get() == userData;
-          });
-
-      CHECK(it != mNonEntityUserDataArray.end());
-
-      /*const auto nextIt = */ mNonEntityUserDataArray.erase(it);
-    }
+    releaseFixtureData(getFixtureData(fixture));
   }
 
   mWorld->DestroyBody(body);
 }
 
 void PhysicalWorld::update(sf::Time dt) {
-  mWorld->Step(static_cast<float32>(dt.asSeconds()), mVelocityIterations,
-               mPositionIterations);
+  {
+    PROFILE_SCOPE("b2World::Step");
+
+    mWorld->Step(static_cast<float32>(dt.asSeconds()), mVelocityIterations,
+                 mPositionIterations);
+  }
 
   NOT_NULL(mPlayerCallback);
 
@@ -597,7 +776,58 @@ void PhysicalWorld::initEntityBodies(const LevelParser &parser,
   }
 }
 
+size_t PhysicalWorld::getBodyCount() const {
+  return static_cast<size_t>(mWorld->GetBodyCount());
+}
+
+size_t PhysicalWorld::getContactCount() const {
+  return static_cast<size_t>(mWorld->GetContactCount());
+}
+
+size_t PhysicalWorld::getProxyCount() const {
+  return static_cast<size_t>(mWorld->GetProxyCount());
+}
+
+PhysicalWorld::TypeMask PhysicalWorld::getTypeMask(OBJECT_TYPE type) {
+  static_assert(TYPE_COUNT <= sizeof(TypeMask) * 8u,
+                "TypeMask is too narrow for OBJECT_TYPE");
+  CHECK(type != OBJECT_TYPE::NONE);
+
+  return TypeMask{1u} << static_cast<size_t>(type);
+}
+
+void PhysicalWorld::queryArea(const sf::FloatRect &area, TypeMask mask,
+                              std::vector<sf::Vector2f> &positions) const {
+  // the y axis points up in Box2D, the bottom of the area is the lower bound
+  b2AABB aabb;
+  aabb.lowerBound = toB2Coords(b2Vec2{area.left, area.top + area.height});
+  aabb.upperBound = toB2Coords(b2Vec2{area.left + area.width, area.top});
+
+  AreaQueryCallback callback{aabb, mask, positions};
+  mWorld->QueryAABB(&callback, aabb);
+}
+
+bool PhysicalWorld::castRay(const sf::Vector2f &from, const sf::Vector2f &to,
+                            TypeMask mask, RayHit &hit) const {
+  // Box2D rejects segments without length
+  if (from == to) {
+    return false;
+  }
+
+  ClosestRayCastCallback callback{mask};
+  mWorld->RayCast(&callback, toB2Coords(b2Vec2{from.x, from.y}),
+                  toB2Coords(b2Vec2{to.x, to.y}));
+
+  return callback.getHit(hit);
+}
+
 void PhysicalWorld::initNonEntityBodies(const LevelParser &parser) {
+  GeometryBaker baker{parser.getTileMapInfo().mTileSize};
+
+  if (parser.hasTileCollision()) {
+    baker.addTiles(parser.getTileMapInfo());
+  }
+
   const auto end = OBJECT_TYPE::NON_ENTITY_TYPES_END;
 
   for (auto type = OBJECT_TYPE::NON_ENTITY_TYPES_START; type < end;
@@ -608,14 +838,20 @@ void PhysicalWorld::initNonEntityBodies(const LevelParser &parser) {
       continue;
     }
 
+    // the tiles replace solid objects
+    if (type == OBJECT_TYPE::SOLID && parser.hasTileCollision()) {
+      continue;
+    }
+
     for (const auto &object : parser.getObjectsFor(type)) {
-      auto userData = makeUnique<UserData>(type);
-      mNonEntityUserDataArray.push_back(std::move(userData));
-      /*b2Body* const rawBody = */ createBody(
-          object, mNonEntityUserDataArray.back().get());
+      if (!bakeShape(baker, type, object)) {
+        /*b2Body* const rawBody = */ createBody(object, type);
+      }
     }
   }
 
+  createStaticGeometry(baker);
+
   const auto ladderType = OBJECT_TYPE::LADDER;
 
   if (!parser.hasType(ladderType)) {
@@ -625,11 +861,7 @@ void PhysicalWorld::initNonEntityBodies(const LevelParser &parser) {
   const auto solidType = OBJECT_TYPE::SOLID_ON_LADDER;
 
   for (const auto &object : parser.getObjectsFor(ladderType)) {
-    auto ladderUserData = makeUnique<UserData>(ladderType);
-    mNonEntityUserDataArray.push_back(std::move(ladderUserData));
-
-    b2Body *const ladderRawBody =
-        createBody(object, mNonEntityUserDataArray.back().get());
+    b2Body *const ladderRawBody = createBody(object, ladderType);
     b2Fixture *const ladderFixture = ladderRawBody->GetFixtureList();
 
     NOT_NULL(ladderFixture);
@@ -638,92 +870,192 @@ void PhysicalWorld::initNonEntityBodies(const LevelParser &parser) {
     const sf::FloatRect solidObject = {object.left, object.top, object.width,
                                        mSolidOnLadderHeight};
 
-    auto solidUserData = makeUnique<UserData>(solidType);
-    mNonEntityUserDataArray.push_back(std::move(solidUserData));
-    b2Body *const solidRawBody =
-        createBody(solidObject, mNonEntityUserDataArray.back().get());
+    b2Body *const solidRawBody = createBody(solidObject, solidType);
     b2Fixture *const solidFixture = solidRawBody->GetFixtureList();
 
     NOT_NULL(solidFixture);
     IS_NULL(solidFixture->GetNext());
 
-    CHECK(mLadderSolidMap.emplace(ladderFixture, solidFixture).second);
+    getFixtureData(ladderFixture)->mLinkedFixture = solidFixture;
+  }
+}
+
+void PhysicalWorld::createStaticGeometry(const GeometryBaker &baker) {
+  const auto outlines = baker.bake();
+
+  if (outlines.empty()) {
+    return;
   }
+
+  b2BodyDef bodyDef;
+  bodyDef.type = b2_staticBody;
+
+  b2Body *const body = mWorld->CreateBody(&bodyDef);
+  const auto type = OBJECT_TYPE::SOLID;
+
+  for (const auto &outline : outlines) {
+    std::vector<b2Vec2> vertices;
+    vertices.reserve(outline.size());
+
+    for (const auto &point : outline) {
+      vertices.push_back(toB2Coords(b2Vec2{point.x, point.y}));
+    }
+
+    // a loop also links its ends, so there are no seams to catch on
+    b2ChainShape chain;
+    chain.CreateLoop(vertices.data(), static_cast<int32>(vertices.size()));
+
+    b2FixtureDef fixtureDef;
+    fixtureDef.shape = &chain;
+    fixtureDef.friction = 0.f;
+    fixtureDef.filter = getCollisionFilter(type);
+    fixtureDef.userData = allocateFixtureData(type, b2Vec2{0.f, 0.f});
+
+    body->CreateFixture(&fixtureDef);
+  }
+
+  LOG("%zu static shapes baked into %zu outlines", baker.getShapeCount(),
+      outlines.size());
 }
 
-b2Body *PhysicalWorld::createBody(const sf::FloatRect &bounds,
-                                  UserData *const userData) {
-  NOT_NULL(userData);
+FixtureData *PhysicalWorld::allocateFixtureData(OBJECT_TYPE type,
+                                                const b2Vec2 &sizeInPixels) {
+  CHECK(type != OBJECT_TYPE::NONE);
 
-  b2Body *const rawBody = createBody(bounds, userData->getType());
-  b2Fixture *const fixture = rawBody->GetFixtureList();
+  const FixtureData fixtureData = {UserData{type}, sizeInPixels, nullptr};
 
-  NOT_NULL(fixture);
-  IS_NULL(fixture->GetNext());
+  if (mFreeFixtureData.empty()) {
+    mFixtureData.push_back(fixtureData);
+    return &mFixtureData.back();
+  }
 
-  fixture->SetUserData(userData);
+  FixtureData *const slot = mFreeFixtureData.back();
+  mFreeFixtureData.pop_back();
+  *slot = fixtureData;
 
-  return rawBody;
+  return slot;
+}
+
+void PhysicalWorld::releaseFixtureData(FixtureData *const fixtureData) {
+  NOT_NULL(fixtureData);
+
+  fixtureData->mLinkedFixture = nullptr;
+  mFreeFixtureData.push_back(fixtureData);
+}
+
+void PhysicalWorld::bakeStaticDrawing() {
+  mStaticVertices.clear();
+
+  // the level is complete here, only dynamic bodies come later
+  for (const b2Body *body = mWorld->GetBodyList(); body != nullptr;
+       body = body->GetNext()) {
+    if (body->GetType() == b2_staticBody) {
+      addBodyToDrawing(mStaticVertices, body);
+    }
+  }
 }
 
 void PhysicalWorld::draw(sf::RenderTarget &target,
                          sf::RenderStates states) const {
-  mVertices.clear();
+  PROFILE_SCOPE("PhysicalWorld::draw");
+
+  mDynamicVertices.clear();
 
   for (const b2Body *body = mWorld->GetBodyList(); body != nullptr;
        body = body->GetNext()) {
-    const auto &posInMeters = body->GetPosition();
-    const b2Fixture *const fixture = body->GetFixtureList();
-
-    NOT_NULL(fixture);
+    if (body->GetType() != b2_staticBody) {
+      addBodyToDrawing(mDynamicVertices, body);
+    }
+  }
 
-    const auto &posInPixels = toSFMLCoords(posInMeters);
-    const auto &sizeInPixels = findFixtureSize(fixture);
-    const sf::Color color = getColor(body->GetType());
-    const auto userDataType = getFixtureUserData(fixture)->getType();
+  target.draw(mStaticVertices, states);
+  target.draw(mDynamicVertices, states);
+}
 
-    CHECK(fixture->GetNext() == nullptr ||
-          userDataType == OBJECT_TYPE::PLAYER_SENSOR);
+void PhysicalWorld::addBodyToDrawing(sf::VertexArray &drawing,
+                                     const b2Body *const body) const {
+  NOT_NULL(body);
 
-    if (userDataType == OBJECT_TYPE::PLAYER_SENSOR) {
-      const b2Fixture *const playerFixture = fixture->GetNext();
+  const auto &posInMeters = body->GetPosition();
+  const b2Fixture *const fixture = body->GetFixtureList();
 
-      NOT_NULL(playerFixture);
+  NOT_NULL(fixture);
 
-      const auto &playerSizeInPixels = findFixtureSize(playerFixture);
-      const auto sensorPos =
-          posInPixels + b2Vec2{mPlayerSensorOffset.x, mPlayerSensorOffset.y};
-      const auto sensorColor =
-          mContactListener->playerOnGround() ? sf::Color::Yellow : color;
+  const sf::Color color = getColor(body->GetType());
 
-      addRectangleToDrawing(posInPixels, playerSizeInPixels, color);
-      addRectangleToDrawing(sensorPos, sizeInPixels, sensorColor);
-    } else if (isSlope(userDataType)) {
-      addTriangleToDrawing(posInPixels, sizeInPixels, color,
-                           userDataType == OBJECT_TYPE::SLOPE_LEFT);
-    } else {
-      addRectangleToDrawing(posInPixels, sizeInPixels, color);
+  // baked geometry, vertices are already in world coordinates
+  if (fixture->GetType() == b2Shape::e_chain) {
+    for (const b2Fixture *chain = fixture; chain != nullptr;
+         chain = chain->GetNext()) {
+      addChainToDrawing(drawing, chain, color);
     }
+
+    return;
   }
 
-  target.draw(mVertices, states);
+  const auto &posInPixels = toSFMLCoords(posInMeters);
+  const auto &sizeInPixels = findFixtureSize(fixture);
+  const auto userDataType = getFixtureUserData(fixture)->getType();
+
+  CHECK(fixture->GetNext() == nullptr ||
+        userDataType == OBJECT_TYPE::PLAYER_SENSOR);
+
+  if (userDataType == OBJECT_TYPE::PLAYER_SENSOR) {
+    const b2Fixture *const playerFixture = fixture->GetNext();
+
+    NOT_NULL(playerFixture);
+
+    const auto &playerSizeInPixels = findFixtureSize(playerFixture);
+    const auto sensorPos =
+        posInPixels + b2Vec2{mPlayerSensorOffset.x, mPlayerSensorOffset.y};
+    const auto sensorColor =
+        mContactListener->playerOnGround() ? sf::Color::Yellow : color;
+
+    addRectangleToDrawing(drawing, posInPixels, playerSizeInPixels, color);
+    addRectangleToDrawing(drawing, sensorPos, sizeInPixels, sensorColor);
+  } else if (isSlope(userDataType)) {
+    addTriangleToDrawing(drawing, posInPixels, sizeInPixels, color,
+                         userDataType == OBJECT_TYPE::SLOPE_LEFT);
+  } else {
+    addRectangleToDrawing(drawing, posInPixels, sizeInPixels, color);
+  }
 }
 
-void PhysicalWorld::addRectangleToDrawing(const b2Vec2 &pos, const b2Vec2 &size,
+void PhysicalWorld::addRectangleToDrawing(sf::VertexArray &drawing,
+                                          const b2Vec2 &pos, const b2Vec2 &size,
                                           const sf::Color &color) const {
   b2Vec2 vertices[RECTANGLE_VERTEX_NUM];
 
   createRectangle(vertices, size);
-  createBoundaryAtPosition(pos, vertices, color);
+  createBoundaryAtPosition(drawing, pos, vertices, color);
 }
 
-void PhysicalWorld::addTriangleToDrawing(const b2Vec2 &pos, const b2Vec2 &size,
+void PhysicalWorld::addTriangleToDrawing(sf::VertexArray &drawing,
+                                         const b2Vec2 &pos, const b2Vec2 &size,
                                          const sf::Color &color,
                                          bool isSlopeLeft) const {
   b2Vec2 vertices[TRIANGLE_VERTEX_NUM];
 
   createTriangle(vertices, isSlopeLeft, size);
-  createBoundaryAtPosition(pos, vertices, color);
+  createBoundaryAtPosition(drawing, pos, vertices, color);
+}
+
+void PhysicalWorld::addChainToDrawing(sf::VertexArray &drawing,
+                                      const b2Fixture *const fixture,
+                                      const sf::Color &color) const {
+  NOT_NULL(fixture);
+  CHECK(fixture->GetType() == b2Shape::e_chain);
+
+  const auto chain = static_cast<const b2ChainShape *>(fixture->GetShape());
+
+  // a loop repeats its first vertex at the end
+  for (int32 i = 1; i < chain->m_count; i++) {
+    const auto from = toSFMLCoords(chain->m_vertices[i - 1]);
+    const auto to = toSFMLCoords(chain->m_vertices[i]);
+
+    drawing.append({{from.x, from.y}, color});
+    drawing.append({{to.x, to.y}, color});
+  }
 }
 
 sf::Vector2f PhysicalWorld::shiftVertexAtPosition(const b2Vec2 &point,
@@ -732,22 +1064,14 @@ sf::Vector2f PhysicalWorld::shiftVertexAtPosition(const b2Vec2 &point,
 }
 
 const b2Vec2 &PhysicalWorld::findFixtureSize(const b2Fixture *fixture) const {
-  CHECK(fixture);
-
-  const auto it = mFixtureSizeMap.find(fixture);
-
-  CHECK(it != mFixtureSizeMap.cend());
-
-  return it->second;
+  return getFixtureData(fixture)->mSizeInPixels;
 }
 
 b2Fixture *
 PhysicalWorld::findSolidOnLadderFixture(const b2Fixture *const ladder) const {
-  CHECK(ladder != nullptr);
-
-  const auto it = mLadderSolidMap.find(ladder);
+  b2Fixture *const solid = getFixtureData(ladder)->mLinkedFixture;
 
-  CHECK(it != mLadderSolidMap.cend());
+  NOT_NULL(solid);
 
-  return it->second;
+  return solid;
 }
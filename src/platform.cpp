@@ -37,7 +37,7 @@ Platform::Platform(std::unique_ptr<PhysicalBody> body)
   NOT_NULL(fixture);
   IS_NULL(fixture->GetNext());
 
-  fixture->SetUserData(getUserData());
+  setFixtureUserData(fixture, *getUserData());
   setEntityPosition(rawBody);
 
   const auto velocity = type == OBJECT_TYPE::HORIZONTAL_PLATFORM
@@ -62,3 +62,5 @@ void Platform::update(sf::Time dt) {
 }
 
 OBJECT_TYPE Platform::getType() const { return mPhysBody->getType(); }
+
+b2Body *Platform::getBody() const { return &mPhysBody->getBody(); }
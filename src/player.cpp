@@ -58,8 +58,8 @@ Player::Player(std::unique_ptr<PhysicalBody> body)
   NOT_NULL(playerFixture);
   IS_NULL(playerFixture->GetNext());
 
-  sensorFixture->SetUserData(&mSensorUserData);
-  playerFixture->SetUserData(getUserData());
+  setFixtureUserData(sensorFixture, mSensorUserData);
+  setFixtureUserData(playerFixture, *getUserData());
   setEntityPosition(rawBody);
   rawBody.SetBullet(true);
 
@@ -231,6 +231,8 @@ bool Player::isDestroyed() const {
 
 OBJECT_TYPE Player::getType() const { return mPlayerType; }
 
+b2Body *Player::getBody() const { return &mPhysBody->getBody(); }
+
 void Player::onGround(bool onGround) { mOnGround = onGround; }
 
 void Player::onLadder(bool onLadder) {
@@ -0,0 +1,234 @@
+#define LOG_TAG "Profiler"
+
+#include "profiler.h"
+#include "core.h"
+#include "utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+namespace {
+using ProfileClock = std::chrono::steady_clock;
+
+const ProfileClock::time_point START_TIME = ProfileClock::now();
+
+thread_local std::uint32_t zoneDepth = 0;
+
+std::int64_t nowInMicroseconds() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             ProfileClock::now() - START_TIME)
+      .count();
+}
+
+bool hasSuffix(const std::string &str, const std::string &suffix) {
+  return str.size() >= suffix.size() &&
+         str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+} // unnamed namespace
+
+struct Profiler::Event {
+  const char *mName;
+  std::int64_t mStart;
+  std::int64_t mDuration;
+  std::uint32_t mDepth;
+};
+
+// written only by its thread; every slot carries the number of the event
+// it holds, so that dump drops the slots that were overwritten while copied
+class Profiler::ThreadBuffer : private sf::NonCopyable {
+public:
+  explicit ThreadBuffer(size_t threadIndex);
+
+  void push(const Event &event);
+  std::vector<Event> getEvents() const;
+
+  size_t getThreadIndex() const;
+
+private:
+  // zero while the slot is being written, event number + 1 otherwise
+  struct Slot {
+    std::atomic<size_t> mSequence;
+    std::atomic<const char *> mName;
+    std::atomic<std::int64_t> mStart;
+    std::atomic<std::int64_t> mDuration;
+    std::atomic<std::uint32_t> mDepth;
+
+    Slot();
+  };
+
+  size_t mThreadIndex;
+  std::vector<Slot> mSlots;
+  std::atomic<size_t> mWriteCount;
+};
+
+Profiler::ThreadBuffer::Slot::Slot()
+    : mSequence(0), mName(nullptr), mStart(0), mDuration(0), mDepth(0) {}
+
+Profiler::ThreadBuffer::ThreadBuffer(size_t threadIndex)
+    : mThreadIndex(threadIndex), mSlots(mEventsPerThread), mWriteCount(0) {}
+
+void Profiler::ThreadBuffer::push(const Event &event) {
+  const auto writeCount = mWriteCount.load(std::memory_order_relaxed);
+  auto &slot = mSlots[writeCount % mSlots.size()];
+
+  slot.mSequence.store(0, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  slot.mName.store(event.mName, std::memory_order_relaxed);
+  slot.mStart.store(event.mStart, std::memory_order_relaxed);
+  slot.mDuration.store(event.mDuration, std::memory_order_relaxed);
+  slot.mDepth.store(event.mDepth, std::memory_order_relaxed);
+
+  slot.mSequence.store(writeCount + 1, std::memory_order_release);
+  mWriteCount.store(writeCount + 1, std::memory_order_release);
+}
+
+std::vector<Profiler::Event> Profiler::ThreadBuffer::getEvents() const {
+  const auto writeCount = mWriteCount.load(std::memory_order_acquire);
+  const auto count = std::min(writeCount, mSlots.size());
+
+  std::vector<Event> events;
+  events.reserve(count);
+
+  // the oldest events are overwritten first, possibly while being copied
+  for (auto i = writeCount - count; i < writeCount; i++) {
+    const auto &slot = mSlots[i % mSlots.size()];
+    const auto sequence = slot.mSequence.load(std::memory_order_acquire);
+
+    if (sequence != i + 1) {
+      continue;
+    }
+
+    const Event event{slot.mName.load(std::memory_order_relaxed),
+                      slot.mStart.load(std::memory_order_relaxed),
+                      slot.mDuration.load(std::memory_order_relaxed),
+                      slot.mDepth.load(std::memory_order_relaxed)};
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (slot.mSequence.load(std::memory_order_relaxed) == sequence) {
+      events.push_back(event);
+    }
+  }
+
+  return events;
+}
+
+size_t Profiler::ThreadBuffer::getThreadIndex() const { return mThreadIndex; }
+
+Profiler::Zone::Zone(const char *name) : mName(nullptr), mStart(0) {
+  if (!isEnabled()) {
+    return;
+  }
+
+  mName = name;
+  mStart = nowInMicroseconds();
+  zoneDepth++;
+}
+
+Profiler::Zone::~Zone() {
+  if (mName == nullptr) {
+    return;
+  }
+
+  zoneDepth--;
+  getThreadBuffer().push(
+      {mName, mStart, nowInMicroseconds() - mStart, zoneDepth});
+}
+
+std::unique_ptr<Profiler> Profiler::mInstance;
+std::atomic<bool> Profiler::mEnabled{false};
+
+const size_t Profiler::mEventsPerThread = 1u << 16;
+
+void Profiler::createInstance() { getInstance(); }
+
+void Profiler::setEnabled(bool enabled) {
+  mEnabled.store(enabled, std::memory_order_relaxed);
+
+  LOG("profiling %s", enabled ? "enabled" : "disabled");
+}
+
+bool Profiler::isEnabled() { return mEnabled.load(std::memory_order_relaxed); }
+
+void Profiler::dump(const std::string &filename) {
+  CHECK(!filename.empty());
+
+  std::ofstream output(filename);
+
+  CHECK(output.is_open());
+
+  const auto &instance = getInstance();
+
+  if (hasSuffix(filename, ".csv")) {
+    instance.dumpCSV(output);
+  } else {
+    instance.dumpTrace(output);
+  }
+
+  CHECK(output.good());
+
+  LOG("profile saved to %s", filename.c_str());
+}
+
+Profiler &Profiler::getInstance() {
+  if (mInstance == nullptr) {
+    mInstance.reset(new (std::nothrow) Profiler{});
+
+    NOT_NULL(mInstance);
+  }
+
+  return *mInstance;
+}
+
+Profiler::ThreadBuffer &Profiler::getThreadBuffer() {
+  // shared with the registry so that dump outlives the thread
+  thread_local std::shared_ptr<ThreadBuffer> buffer;
+
+  if (buffer == nullptr) {
+    auto &instance = getInstance();
+    std::lock_guard<std::mutex> lock(instance.mBufferMutex);
+
+    buffer = makeShared<ThreadBuffer>(instance.mBuffers.size());
+    instance.mBuffers.push_back(buffer);
+  }
+
+  return *buffer;
+}
+
+Profiler::Profiler() : mBufferMutex(), mBuffers() {}
+
+void Profiler::dumpTrace(std::ostream &output) const {
+  std::lock_guard<std::mutex> lock(mBufferMutex);
+
+  output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  bool first = true;
+
+  for (const auto &buffer : mBuffers) {
+    for (const auto &event : buffer->getEvents()) {
+      output << (first ? "\n" : ",\n") << "{\"name\":\"" << event.mName
+             << "\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+             << buffer->getThreadIndex() << ",\"ts\":" << event.mStart
+             << ",\"dur\":" << event.mDuration << "}";
+      first = false;
+    }
+  }
+
+  output << "\n]}\n";
+}
+
+void Profiler::dumpCSV(std::ostream &output) const {
+  std::lock_guard<std::mutex> lock(mBufferMutex);
+
+  output << "thread,depth,name,start_us,duration_us\n";
+
+  for (const auto &buffer : mBuffers) {
+    for (const auto &event : buffer->getEvents()) {
+      output << buffer->getThreadIndex() << "," << event.mDepth << ","
+             << event.mName << "," << event.mStart << "," << event.mDuration
+             << "\n";
+    }
+  }
+}
@@ -9,61 +9,287 @@
 
 #include <SFML/Audio/SoundBuffer.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
+#include <mutex>
+#include <set>
+
+namespace {
+// decoded size, what the resource takes in memory once loaded
+size_t getMemorySize(const sf::Texture &texture) {
+  const auto size = texture.getSize();
+
+  return static_cast<size_t>(size.x) * size.y * 4u;
+}
+
+size_t getMemorySize(const sf::Image &image) {
+  const auto size = image.getSize();
+
+  return static_cast<size_t>(size.x) * size.y * 4u;
+}
+
+// glyphs are rendered on demand, SFML doesn't tell how many
+size_t getMemorySize(const sf::Font & /*font*/) { return 0u; }
+
+size_t getMemorySize(const sf::SoundBuffer &soundBuffer) {
+  return static_cast<size_t>(soundBuffer.getSampleCount()) *
+         sizeof(sf::Int16);
+}
+} // unnamed namespace
+
+// sounds are loaded from the pipelined tick and files are decoded by the
+// asset loader, so the holder is locked; loading happens outside the lock
 template <typename RESOURCE_TYPE>
 class ResourceManager::ResourceHolder : private sf::NonCopyable {
 public:
-  explicit ResourceHolder(const std::string &resourceDir);
+  using Handle = std::shared_ptr<const RESOURCE_TYPE>;
 
-  const RESOURCE_TYPE &get(const std::string &filename) const;
+  ResourceHolder(const std::string &resourceDir, size_t budget);
+
+  bool contains(const std::string &filename) const;
+  const std::set<std::string> &getFilenames() const;
+
+  // the resource is pinned and stays resident until exit
+  const RESOURCE_TYPE &get(const std::string &filename);
+
+  // the resource may be evicted once the handle and its copies are gone
+  Handle acquire(const std::string &filename);
+
+  // for a resource built by the caller, an already resident one wins
+  Handle add(const std::string &filename,
+             std::shared_ptr<RESOURCE_TYPE> resource);
+
+  // nullptr if the resource is not resident, nothing is loaded
+  Handle find(const std::string &filename) const;
+  std::vector<std::string> getResidentFilenames() const;
+
+  // drops the resource unless it is pinned or referenced
+  void release(const std::string &filename);
+
+  void setBudget(size_t budget);
+  size_t getResidentSize() const;
 
 private:
+  struct Entry {
+    Handle mResource;
+    size_t mSize;
+    bool mPinned;
+    size_t mLastUse;
+  };
+
   std::string mResourceDir;
-  std::map<const std::string, const std::unique_ptr<const RESOURCE_TYPE>>
-      mResourceMap;
+  std::set<std::string> mFilenames;
+
+  mutable std::mutex mMutex;
+  std::map<const std::string, Entry> mEntries;
+  size_t mBudget;
+  size_t mResidentSize;
+  size_t mUseCounter;
+
+  Handle use(const std::string &filename, bool pin);
+  Handle insert(const std::string &filename,
+                std::shared_ptr<RESOURCE_TYPE> resource, bool pin);
 
-  void load(const std::string &filename);
+  // these expect mMutex to be locked
+  void touch(Entry &entry, bool pin);
+  void evict();
 };
 
 template <typename RESOURCE_TYPE>
 ResourceManager::ResourceHolder<RESOURCE_TYPE>::ResourceHolder(
-    const std::string &resourceDir)
-    : mResourceDir(), mResourceMap() {
+    const std::string &resourceDir, size_t budget)
+    : mResourceDir(), mFilenames(), mMutex(), mEntries(), mBudget(budget),
+      mResidentSize(0u), mUseCounter(0u) {
   CHECK(!resourceDir.empty());
 
   mResourceDir = resourceDir;
 
+  // only the names are read, files are loaded on first use
   for (const auto &filename : listDirectory(resourceDir)) {
-    load(filename);
+    CHECK(mFilenames.insert(filename).second);
   }
 }
 
-template <typename ResourceType>
-const ResourceType &ResourceManager::ResourceHolder<ResourceType>::get(
+template <typename RESOURCE_TYPE>
+bool ResourceManager::ResourceHolder<RESOURCE_TYPE>::contains(
     const std::string &filename) const {
-  CHECK(!filename.empty());
+  return mFilenames.find(filename) != mFilenames.cend();
+}
+
+template <typename RESOURCE_TYPE>
+const std::set<std::string> &
+ResourceManager::ResourceHolder<RESOURCE_TYPE>::getFilenames() const {
+  return mFilenames;
+}
+
+template <typename RESOURCE_TYPE>
+const RESOURCE_TYPE &ResourceManager::ResourceHolder<RESOURCE_TYPE>::get(
+    const std::string &filename) {
+  // the entry keeps a pinned resource alive
+  return *use(filename, true);
+}
 
-  const auto it = mResourceMap.find(filename);
+template <typename RESOURCE_TYPE>
+typename ResourceManager::ResourceHolder<RESOURCE_TYPE>::Handle
+ResourceManager::ResourceHolder<RESOURCE_TYPE>::acquire(
+    const std::string &filename) {
+  return use(filename, false);
+}
+
+template <typename RESOURCE_TYPE>
+typename ResourceManager::ResourceHolder<RESOURCE_TYPE>::Handle
+ResourceManager::ResourceHolder<RESOURCE_TYPE>::add(
+    const std::string &filename, std::shared_ptr<RESOURCE_TYPE> resource) {
+  CHECK(contains(filename));
+  NOT_NULL(resource);
+
+  return insert(filename, std::move(resource), false);
+}
+
+template <typename RESOURCE_TYPE>
+typename ResourceManager::ResourceHolder<RESOURCE_TYPE>::Handle
+ResourceManager::ResourceHolder<RESOURCE_TYPE>::find(
+    const std::string &filename) const {
+  std::lock_guard<std::mutex> lock{mMutex};
 
-  CHECK(it != mResourceMap.cend());
+  const auto it = mEntries.find(filename);
 
-  return *it->second;
+  return it != mEntries.cend() ? it->second.mResource : nullptr;
 }
 
 template <typename RESOURCE_TYPE>
-void ResourceManager::ResourceHolder<RESOURCE_TYPE>::load(
+std::vector<std::string>
+ResourceManager::ResourceHolder<RESOURCE_TYPE>::getResidentFilenames() const {
+  std::lock_guard<std::mutex> lock{mMutex};
+
+  std::vector<std::string> filenames;
+
+  for (const auto &pair : mEntries) {
+    filenames.push_back(pair.first);
+  }
+
+  return filenames;
+}
+
+template <typename RESOURCE_TYPE>
+void ResourceManager::ResourceHolder<RESOURCE_TYPE>::release(
     const std::string &filename) {
+  std::lock_guard<std::mutex> lock{mMutex};
+
+  const auto it = mEntries.find(filename);
+
+  if (it != mEntries.end() && !it->second.mPinned &&
+      it->second.mResource.use_count() == 1) {
+    mResidentSize -= it->second.mSize;
+    mEntries.erase(it);
+  }
+}
+
+template <typename RESOURCE_TYPE>
+void ResourceManager::ResourceHolder<RESOURCE_TYPE>::setBudget(
+    size_t budget) {
+  std::lock_guard<std::mutex> lock{mMutex};
+
+  mBudget = budget;
+  evict();
+}
+
+template <typename RESOURCE_TYPE>
+size_t ResourceManager::ResourceHolder<RESOURCE_TYPE>::getResidentSize() const {
+  std::lock_guard<std::mutex> lock{mMutex};
+
+  return mResidentSize;
+}
+
+template <typename RESOURCE_TYPE>
+typename ResourceManager::ResourceHolder<RESOURCE_TYPE>::Handle
+ResourceManager::ResourceHolder<RESOURCE_TYPE>::use(
+    const std::string &filename, bool pin) {
   CHECK(!filename.empty());
+  CHECK(contains(filename));
+
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    const auto it = mEntries.find(filename);
+
+    if (it != mEntries.end()) {
+      touch(it->second, pin);
+
+      return it->second.mResource;
+    }
+  }
 
-  auto resource = makeUnique<RESOURCE_TYPE>();
+  // several files are decoded at once by the asset loader
+  auto resource = makeShared<RESOURCE_TYPE>();
 
   CHECK(resource->loadFromFile(mResourceDir + filename));
-  CHECK(mResourceMap.emplace(filename, std::move(resource)).second);
+
+  return insert(filename, std::move(resource), pin);
+}
+
+template <typename RESOURCE_TYPE>
+typename ResourceManager::ResourceHolder<RESOURCE_TYPE>::Handle
+ResourceManager::ResourceHolder<RESOURCE_TYPE>::insert(
+    const std::string &filename, std::shared_ptr<RESOURCE_TYPE> resource,
+    bool pin) {
+  std::lock_guard<std::mutex> lock{mMutex};
+
+  // another thread may have loaded the same file meanwhile
+  auto it = mEntries.find(filename);
+
+  if (it == mEntries.end()) {
+    const auto size = getMemorySize(*resource);
+    it = mEntries.emplace(filename, Entry{std::move(resource), size, false, 0u})
+             .first;
+    mResidentSize += size;
+  }
+
+  touch(it->second, pin);
+
+  // the extra reference keeps the resource just used from being evicted
+  const auto result = it->second.mResource;
+  evict();
+
+  return result;
+}
+
+template <typename RESOURCE_TYPE>
+void ResourceManager::ResourceHolder<RESOURCE_TYPE>::touch(Entry &entry,
+                                                           bool pin) {
+  entry.mLastUse = ++mUseCounter;
+  entry.mPinned = entry.mPinned || pin;
+}
+
+template <typename RESOURCE_TYPE>
+void ResourceManager::ResourceHolder<RESOURCE_TYPE>::evict() {
+  while (mResidentSize > mBudget) {
+    auto victim = mEntries.end();
+
+    // the holder owns the only reference of an unused resource
+    for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+      const auto &entry = it->second;
+
+      if (!entry.mPinned && entry.mResource.use_count() == 1 &&
+          (victim == mEntries.end() ||
+           entry.mLastUse < victim->second.mLastUse)) {
+        victim = it;
+      }
+    }
+
+    if (victim == mEntries.end()) {
+      return;
+    }
+
+    mResidentSize -= victim->second.mSize;
+    mEntries.erase(victim);
+  }
 }
 
 std::unique_ptr<const ResourceManager> ResourceManager::mInstance;
+bool ResourceManager::mHeadless = false;
 
 const std::string ResourceManager::mLevelTextures[] = {
     "Snow.png",
@@ -71,25 +297,117 @@ const std::string ResourceManager::mLevelTextures[] = {
     "Clouds.png",
 };
 
+const size_t ResourceManager::mDefaultMemoryBudget = 64u * 1024u * 1024u;
+
 void ResourceManager::createInstance() {
   /*const auto& instance = */ getInstance();
 }
 
+void ResourceManager::createHeadlessInstance() {
+  IS_NULL(mInstance);
+
+  mHeadless = true;
+  getInstance();
+}
+
+bool ResourceManager::isHeadless() { return mHeadless; }
+
 sf::RenderWindow &ResourceManager::getWindow() {
-  return *getInstance().mWindow;
+  const auto &window = getInstance().mWindow;
+
+  NOT_NULL(window);
+
+  return *window;
 }
 
 const sf::Texture &ResourceManager::getTexture(const std::string &filename) {
-  return getInstance().mTextureHolder->get(filename);
+  const auto &instance = getInstance();
+
+  // pinned textures are used by the states, which don't exist headless
+  CHECK(!isHeadless());
+
+  instance.uploadDecodedTexture(filename);
+
+  return instance.mTextureHolder->get(filename);
+}
+
+TextureHandle ResourceManager::acquireTexture(const std::string &filename) {
+  const auto &instance = getInstance();
+
+  if (isHeadless()) {
+    // validate the name even though the texture is not loaded; any
+    // sf::Texture would create a GL context, which needs a display
+    CHECK(instance.mImageHolder->contains(filename));
+
+    return nullptr;
+  }
+
+  instance.uploadDecodedTexture(filename);
+
+  return instance.mTextureHolder->acquire(filename);
+}
+
+sf::Vector2u ResourceManager::getTextureSize(const std::string &filename) {
+  const auto &instance = getInstance();
+
+  if (!isHeadless()) {
+    const auto texture = instance.mTextureHolder->find(filename);
+
+    if (texture != nullptr) {
+      return texture->getSize();
+    }
+  }
+
+  // the image is decoded without a context, so any thread may ask;
+  // it waits for the upload under the memory budget
+  return instance.mImageHolder->acquire(filename)->getSize();
+}
+
+void ResourceManager::decodeTexture(const std::string &filename) {
+  /*const auto& image = */ getInstance().mImageHolder->acquire(filename);
+}
+
+std::vector<std::string> ResourceManager::getDecodedTextures() {
+  if (isHeadless()) {
+    return {};
+  }
+
+  return getInstance().mImageHolder->getResidentFilenames();
+}
+
+void ResourceManager::uploadTexture(const std::string &filename) {
+  CHECK(!isHeadless());
+
+  getInstance().uploadDecodedTexture(filename);
 }
 
 const sf::Font &ResourceManager::getFont(const std::string &filename) {
-  return getInstance().mFontHolder->get(filename);
+  const auto &fontHolder = getInstance().mFontHolder;
+
+  NOT_NULL(fontHolder);
+
+  return fontHolder->get(filename);
 }
 
 const sf::SoundBuffer &
 ResourceManager::getSoundBuffer(const std::string filename) {
-  return getInstance().mSoundHolder->get(filename);
+  const auto &soundHolder = getInstance().mSoundHolder;
+
+  NOT_NULL(soundHolder);
+
+  return soundHolder->get(filename);
+}
+
+std::vector<std::string> ResourceManager::getFontNames() {
+  const auto &filenames = getInstance().mFontHolder->getFilenames();
+
+  return {filenames.cbegin(), filenames.cend()};
+}
+
+std::vector<std::string> ResourceManager::getSoundNames() {
+  const auto &filenames = getInstance().mSoundHolder->getFilenames();
+
+  return {filenames.cbegin(), filenames.cend()};
 }
 
 size_t ResourceManager::getLevelCount() { return arraySize(mLevelTextures); }
@@ -97,18 +415,65 @@ size_t ResourceManager::getLevelCount() { return arraySize(mLevelTextures); }
 const LevelParser &ResourceManager::getLevelParser(size_t level) {
   CHECK(level < getLevelCount());
 
-  const auto &levelParserMap = getInstance().mLevelParserMap;
-  const auto it = levelParserMap.find(level);
+  const auto &instance = getInstance();
+
+  {
+    std::lock_guard<std::mutex> lock{instance.mLevelMutex};
+
+    const auto it = instance.mLevelParserMap.find(level);
+
+    if (it != instance.mLevelParserMap.cend()) {
+      return *it->second;
+    }
+  }
+
+  // levels are parsed on first use, the asset loader parses them at once
+  const auto fileIt = instance.mLevelFileMap.find(level);
+
+  CHECK(fileIt != instance.mLevelFileMap.cend());
 
-  CHECK(it != levelParserMap.cend());
+  auto levelParser = makeUnique<LevelParser>(LEVELS_DIR + fileIt->second);
 
-  return *it->second;
+  std::lock_guard<std::mutex> lock{instance.mLevelMutex};
+
+  // a parser added by another thread meanwhile wins
+  return *instance.mLevelParserMap.emplace(level, std::move(levelParser))
+              .first->second;
 }
 
-const sf::Texture &ResourceManager::getLevelTexture(size_t level) {
+TextureHandle ResourceManager::getLevelTexture(size_t level) {
   CHECK(level < getLevelCount());
 
-  return getTexture(mLevelTextures[level]);
+  return acquireTexture(mLevelTextures[level]);
+}
+
+std::vector<std::string> ResourceManager::getLevelManifest(size_t level) {
+  const auto &info = getLevelParser(level).getTileMapInfo();
+
+  return {mLevelTextures[level], info.mTilesetTextureName};
+}
+
+void ResourceManager::setMemoryBudget(size_t budget) {
+  const auto &instance = getInstance();
+
+  instance.mImageHolder->setBudget(budget);
+
+  if (!isHeadless()) {
+    instance.mTextureHolder->setBudget(budget);
+  }
+}
+
+size_t ResourceManager::getResidentMemory() {
+  const auto &instance = getInstance();
+
+  if (isHeadless()) {
+    return instance.mImageHolder->getResidentSize();
+  }
+
+  return instance.mTextureHolder->getResidentSize() +
+         instance.mImageHolder->getResidentSize() +
+         instance.mFontHolder->getResidentSize() +
+         instance.mSoundHolder->getResidentSize();
 }
 
 const ResourceManager &ResourceManager::getInstance() {
@@ -122,12 +487,22 @@ const ResourceManager &ResourceManager::getInstance() {
 }
 
 ResourceManager::ResourceManager()
-    : mWindow(makeUnique<sf::RenderWindow>(
-          sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), APPLICATION_NAME,
-          static_cast<sf::Uint32>(sf::Style::Titlebar | sf::Style::Close))),
-      mTextureHolder(makeUnique<TextureHolder>(TEXTURES_DIR)),
-      mFontHolder(makeUnique<FontHolder>(FONTS_DIR)),
-      mSoundHolder(makeUnique<SoundHolder>(SOUNDS_DIR)), mLevelParserMap() {
+    : mWindow(), mTextureHolder(), mImageHolder(), mFontHolder(),
+      mSoundHolder(), mLevelFileMap(), mLevelMutex(), mLevelParserMap() {
+  // images are decoded on the CPU and need neither a display nor a context
+  mImageHolder = makeUnique<ImageHolder>(TEXTURES_DIR, mDefaultMemoryBudget);
+
+  if (!isHeadless()) {
+    mWindow = makeUnique<sf::RenderWindow>(
+        sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), APPLICATION_NAME,
+        static_cast<sf::Uint32>(sf::Style::Titlebar | sf::Style::Close));
+    mTextureHolder =
+        makeUnique<TextureHolder>(TEXTURES_DIR, mDefaultMemoryBudget);
+    // fonts and sounds are small and always pinned, they are never evicted
+    mFontHolder = makeUnique<FontHolder>(FONTS_DIR, mDefaultMemoryBudget);
+    mSoundHolder = makeUnique<SoundHolder>(SOUNDS_DIR, mDefaultMemoryBudget);
+  }
+
   const std::string levelPrefix = "Level_";
   const auto levelPrefixSize = levelPrefix.size();
   const std::string levelSuffix = ".tmx";
@@ -147,14 +522,40 @@ ResourceManager::ResourceManager()
 
     CHECK(levelNumber > 0 && levelNumber <= getLevelCount());
 
-    auto levelParser = makeUnique<LevelParser>(filename);
-
-    CHECK(mLevelParserMap.emplace(levelNumber - 1, std::move(levelParser))
-              .second);
+    CHECK(mLevelFileMap.emplace(levelNumber - 1, filename).second);
   }
 
-  CHECK(mLevelParserMap.size() == arraySize(mLevelTextures));
+  CHECK(mLevelFileMap.size() == arraySize(mLevelTextures));
+
+  if (isHeadless()) {
+    return;
+  }
 
   MusicPlayer::createInstance();
   SoundPlayer::createInstance();
 }
+
+void ResourceManager::uploadDecodedTexture(const std::string &filename) const {
+  // a texture decoded by the asset loader is made from its image
+  // instead of reading the file again
+  if (mTextureHolder->find(filename) != nullptr) {
+    return;
+  }
+
+  {
+    const auto image = mImageHolder->find(filename);
+
+    if (image == nullptr) {
+      return;
+    }
+
+    auto texture = makeShared<sf::Texture>();
+
+    CHECK(texture->loadFromImage(*image));
+
+    /*const auto& texture = */ mTextureHolder->add(filename,
+                                                   std::move(texture));
+  }
+
+  mImageHolder->release(filename);
+}
@@ -6,10 +6,19 @@
 #include "core.h"
 #include "objectType.h"
 #include "physicalBody.h"
+#include "physicalWorld.h"
 #include "utils.h"
 
 #include <Box2D/Dynamics/b2Fixture.h>
 
+namespace {
+const PhysicalWorld::TypeMask WALL_MASK =
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::SOLID) |
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::SOLID_ON_LADDER) |
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::HORIZONTAL_PLATFORM) |
+    PhysicalWorld::getTypeMask(OBJECT_TYPE::VERTICAL_PLATFORM);
+} // unnamed namespace
+
 const int Runner::mRunnerHitpoints = 1;
 const OBJECT_TYPE Runner::mRunnerType = OBJECT_TYPE::RUNNER;
 const ANIMATION_TYPE Runner::mRunnerAnimationType = ANIMATION_TYPE::RUNNER;
@@ -17,6 +26,8 @@ const b2Vec2 Runner::mRunnerVelocity = {20.f, 0.f};
 
 const sf::Time Runner::mTurnDelay = sf::seconds(1.5f);
 
+const float Runner::mWallDistance = 4.f;
+
 Runner::Runner(std::unique_ptr<PhysicalBody> body)
     : Entity{mRunnerHitpoints, mRunnerType, mRunnerAnimationType,
              HEADING::RIGHT},
@@ -32,7 +43,7 @@ Runner::Runner(std::unique_ptr<PhysicalBody> body)
   NOT_NULL(fixture);
   IS_NULL(fixture->GetNext());
 
-  fixture->SetUserData(getUserData());
+  setFixtureUserData(fixture, *getUserData());
   setEntityPosition(rawBody);
 
   rawBody.SetLinearVelocity(toB2Coords(mRunnerVelocity));
@@ -43,13 +54,13 @@ void Runner::update(sf::Time dt) {
 
   while (mTimeSinceLastTurn > mTurnDelay) {
     mTimeSinceLastTurn -= mTurnDelay;
+    turn();
+  }
 
-    auto &rawBody = mPhysBody->getBody();
-    auto velocity = rawBody.GetLinearVelocity();
-    velocity.x *= -1.f;
-    rawBody.SetLinearVelocity(velocity);
-
-    changeHeading();
+  // pushing against a wall would stop the body for good
+  if (isWallAhead()) {
+    mTimeSinceLastTurn = sf::Time::Zero;
+    turn();
   }
 
   getAnimationManager().update(dt);
@@ -57,3 +68,29 @@ void Runner::update(sf::Time dt) {
 }
 
 OBJECT_TYPE Runner::getType() const { return mRunnerType; }
+
+b2Body *Runner::getBody() const { return &mPhysBody->getBody(); }
+
+void Runner::turn() {
+  changeHeading();
+
+  // the velocity follows the heading, a wall may have zeroed it
+  const float speed = toMeters(mRunnerVelocity.x);
+
+  auto &rawBody = mPhysBody->getBody();
+  auto velocity = rawBody.GetLinearVelocity();
+  velocity.x = getHeading() == HEADING::RIGHT ? speed : -speed;
+  rawBody.SetLinearVelocity(velocity);
+}
+
+bool Runner::isWallAhead() const {
+  const float direction = getHeading() == HEADING::RIGHT ? 1.f : -1.f;
+  const float reach = mPhysBody->getBounds().width / 2.f + mWallDistance;
+  const auto &position = getPosition();
+  const sf::Vector2f ahead = {position.x + direction * reach, position.y};
+
+  PhysicalWorld::RayHit hit;
+
+  return mPhysBody->getPhysicalWorld().castRay(position, ahead, WALL_MASK,
+                                               hit);
+}
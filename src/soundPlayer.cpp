@@ -7,6 +7,7 @@
 #include <SFML/Audio/Listener.hpp>
 #include <SFML/Audio/Sound.hpp>
 
+#include <algorithm>
 #include <cmath>
 
 std::unique_ptr<SoundPlayer> SoundPlayer::mInstance;
@@ -27,9 +28,16 @@ void SoundPlayer::play(const std::string &filename,
                        const sf::Vector2f &position) {
   CHECK(!filename.empty());
 
+  if (ResourceManager::isHeadless()) {
+    return;
+  }
+
   const auto &soundBuffer = ResourceManager::getSoundBuffer(filename);
 
-  auto &sounds = getInstance().mSounds;
+  auto &instance = getInstance();
+  const std::lock_guard<std::mutex> lock{instance.mSoundMutex};
+
+  auto &sounds = instance.mSounds;
   sounds.emplace_back(soundBuffer);
   auto &newSound = sounds.back();
 
@@ -41,11 +49,29 @@ void SoundPlayer::play(const std::string &filename,
 }
 
 void SoundPlayer::removeStopped() {
-  getInstance().mSounds.remove_if(
+  auto &instance = getInstance();
+  const std::lock_guard<std::mutex> lock{instance.mSoundMutex};
+
+  instance.mSounds.remove_if(
       [](sf::Sound &s) { return s.getStatus() == sf::Sound::Stopped; });
 }
 
+size_t SoundPlayer::getVoiceCount() {
+  auto &instance = getInstance();
+  const std::lock_guard<std::mutex> lock{instance.mSoundMutex};
+
+  const auto &sounds = instance.mSounds;
+
+  return std::count_if(sounds.cbegin(), sounds.cend(), [](const sf::Sound &s) {
+    return s.getStatus() == sf::Sound::Playing;
+  });
+}
+
 void SoundPlayer::setListenerPosition(const sf::Vector2f &position) {
+  if (ResourceManager::isHeadless()) {
+    return;
+  }
+
   sf::Listener::setPosition(position.x, -position.y, mListenerPositionZ);
 }
 
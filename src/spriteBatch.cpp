@@ -0,0 +1,94 @@
+#define LOG_TAG "SpriteBatch"
+
+#include "spriteBatch.h"
+#include "core.h"
+#include "utils.h"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Transform.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+const size_t SpriteBatch::mQuadVertexCount = RECTANGLE_VERTEX_NUM;
+
+SpriteBatch::SpriteBatch()
+    : mQuads(), mVertices(), mSortedVertices(), mDrawCallCount(0) {}
+
+void SpriteBatch::clear() {
+  mQuads.clear();
+  mVertices.clear();
+}
+
+void SpriteBatch::add(const sf::Texture &texture,
+                      const sf::IntRect &textureRect,
+                      const sf::Transform &transform, size_t layer) {
+  mQuads.push_back({layer, &texture, mVertices.size()});
+
+  const auto width = static_cast<float>(std::abs(textureRect.width));
+  const auto height = static_cast<float>(std::abs(textureRect.height));
+
+  // same corners and texture coordinates as sf::Sprite
+  const auto left = static_cast<float>(textureRect.left);
+  const auto top = static_cast<float>(textureRect.top);
+  const auto right = left + textureRect.width;
+  const auto bottom = top + textureRect.height;
+
+  const sf::Vertex topLeft = {transform.transformPoint(0.f, 0.f),
+                              {left, top}};
+  const sf::Vertex topRight = {transform.transformPoint(width, 0.f),
+                               {right, top}};
+  const sf::Vertex bottomLeft = {transform.transformPoint(0.f, height),
+                                 {left, bottom}};
+  const sf::Vertex bottomRight = {transform.transformPoint(width, height),
+                                  {right, bottom}};
+
+  // clockwise, as the tile map quads
+  mVertices.push_back(topLeft);
+  mVertices.push_back(topRight);
+  mVertices.push_back(bottomRight);
+  mVertices.push_back(bottomLeft);
+}
+
+void SpriteBatch::render(sf::RenderTarget &target, sf::RenderStates states) {
+  mDrawCallCount = 0;
+
+  // stable, so quads of one run keep the order they were added in
+  std::stable_sort(mQuads.begin(), mQuads.end(),
+                   [](const Quad &lhs, const Quad &rhs) {
+                     if (lhs.mLayer != rhs.mLayer) {
+                       return lhs.mLayer < rhs.mLayer;
+                     }
+
+                     return std::less<const sf::Texture *>()(lhs.mTexture,
+                                                             rhs.mTexture);
+                   });
+
+  mSortedVertices.clear();
+
+  for (const auto &quad : mQuads) {
+    const auto first = mVertices.cbegin() + quad.mFirstVertex;
+
+    mSortedVertices.insert(mSortedVertices.end(), first,
+                           first + mQuadVertexCount);
+  }
+
+  for (size_t begin = 0; begin < mQuads.size();) {
+    size_t end = begin + 1;
+
+    while (end < mQuads.size() && mQuads[end].mLayer == mQuads[begin].mLayer &&
+           mQuads[end].mTexture == mQuads[begin].mTexture) {
+      end++;
+    }
+
+    states.texture = mQuads[begin].mTexture;
+    target.draw(&mSortedVertices[begin * mQuadVertexCount],
+                (end - begin) * mQuadVertexCount, sf::Quads, states);
+
+    mDrawCallCount++;
+    begin = end;
+  }
+}
+
+size_t SpriteBatch::getDrawCallCount() const { return mDrawCallCount; }
@@ -11,3 +11,7 @@ StateBase::StateBase(StateManager &stateManager)
 StateManager &StateBase::getStateManager() const { return mStateManager; }
 
 void StateBase::update(sf::Time /*dt*/) {}
+
+void StateBase::setInterpolation(float /*interpolation*/) {}
+
+const World *StateBase::getWorld() const { return nullptr; }
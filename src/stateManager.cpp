@@ -6,9 +6,11 @@
 #include "gameState.h"
 #include "intermediateState.h"
 #include "introState.h"
+#include "loadingState.h"
 #include "menuState.h"
 #include "musicPlayer.h"
 #include "pauseState.h"
+#include "performanceOverlay.h"
 #include "resourceManager.h"
 #include "settingsState.h"
 #include "soundPlayer.h"
@@ -17,13 +19,19 @@
 
 #include <SFML/Window/Event.hpp>
 
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 
-const STATE_TYPE StateManager::mInitialStateType = STATE_TYPE::INTRO;
+const STATE_TYPE StateManager::mInitialStateType = STATE_TYPE::LOADING;
+const sf::Keyboard::Key StateManager::mOverlayToggleKey = sf::Keyboard::F1;
 
 StateManager::StateManager()
     : mState(), mCachedState(), mCurrentStateType(STATE_TYPE::NONE),
-      mDestinationStateType(STATE_TYPE::NONE), mCurrentLevel(0) {
+      mDestinationStateType(STATE_TYPE::NONE), mCurrentLevel(0),
+      mPipelined(false), mOverlay(makeUnique<PerformanceOverlay>()),
+      mScene(makeUnique<sf::RenderTexture>()) {
+  CHECK(mScene->create(WINDOW_WIDTH, WINDOW_HEIGHT));
+
   requestStateTranstion(mInitialStateType);
   handleStateTransition();
 }
@@ -33,6 +41,12 @@ StateManager::~StateManager() {}
 void StateManager::handleEvent(const sf::Event &event) {
   CHECK(hasState());
 
+  if (event.type == sf::Event::KeyPressed &&
+      event.key.code == mOverlayToggleKey) {
+    mOverlay->toggle();
+    return;
+  }
+
   mState->handleEvent(event);
 }
 
@@ -48,6 +62,17 @@ void StateManager::update(sf::Time dt) {
   }
 }
 
+void StateManager::setInterpolation(float interpolation) {
+  CHECK(hasState());
+
+  mState->setInterpolation(interpolation);
+}
+
+void StateManager::addFrame(sf::Time frameTime, sf::Time tickTime,
+                            sf::Time renderTime) {
+  mOverlay->addFrame(frameTime, tickTime, renderTime, getWorld());
+}
+
 STATE_TYPE StateManager::getCurrentStateType() const {
   CHECK(!hasStateTransition());
 
@@ -72,10 +97,31 @@ void StateManager::increaseLevel() {
   mCurrentLevel++;
 }
 
+void StateManager::setPipelined(bool pipelined) { mPipelined = pipelined; }
+
+bool StateManager::isPipelined() const { return mPipelined; }
+
+sf::RenderTexture &StateManager::getScene() const { return *mScene; }
+
+const sf::Texture &StateManager::getSceneTexture() const {
+  return mScene->getTexture();
+}
+
 bool StateManager::hasState() const {
   return mState != nullptr && mCurrentStateType != STATE_TYPE::NONE;
 }
 
+const World *StateManager::getWorld() const {
+  CHECK(hasState());
+
+  // paused GameState is cached
+  if (mCachedState != nullptr) {
+    return mCachedState->getWorld();
+  }
+
+  return mState->getWorld();
+}
+
 bool StateManager::hasStateTransition() const {
   return mDestinationStateType != STATE_TYPE::NONE;
 }
@@ -83,9 +129,11 @@ bool StateManager::hasStateTransition() const {
 void StateManager::handleStateTransition() {
   CHECK(hasStateTransition());
 
-  if (mDestinationStateType == STATE_TYPE::INTRO) {
+  if (mDestinationStateType == STATE_TYPE::LOADING) {
     IS_NULL(mState);
 
+    mState = makeUnique<LoadingState>(*this);
+  } else if (mDestinationStateType == STATE_TYPE::INTRO) {
     mState = makeUnique<IntroState>(*this);
   } else if (mDestinationStateType == STATE_TYPE::MENU) {
     resetLevel();
@@ -145,8 +193,10 @@ bool StateManager::permitedTransition(STATE_TYPE destinationType) const {
   CHECK(!hasStateTransition());
 
   switch (destinationType) {
-  case STATE_TYPE::INTRO:
+  case STATE_TYPE::LOADING:
     return mCurrentStateType == STATE_TYPE::NONE;
+  case STATE_TYPE::INTRO:
+    return mCurrentStateType == STATE_TYPE::LOADING;
   case STATE_TYPE::MENU:
     return mCurrentStateType == STATE_TYPE::INTRO ||
            mCurrentStateType == STATE_TYPE::SETTINGS ||
@@ -177,4 +227,12 @@ void StateManager::draw(sf::RenderTarget &target,
   CHECK(hasState());
 
   target.draw(*mState, states);
+
+  if (mOverlay->isVisible()) {
+    const auto view = target.getView();
+
+    target.setView(target.getDefaultView());
+    target.draw(*mOverlay, states);
+    target.setView(view);
+  }
 }
@@ -9,9 +9,14 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
+#include <algorithm>
+#include <cmath>
+
+const unsigned int TileMap::mChunkTileCount = 16u;
+
 TileMap::TileMap(const TileMapInfo &info)
-    : mTexture(ResourceManager::getTexture(info.mTilesetTextureName)),
-      mVertices(sf::Quads), mMapSize(), mTileSize(0u) {
+    : mTexture(ResourceManager::acquireTexture(info.mTilesetTextureName)),
+      mBatches(), mChunkCount(), mMapSize(), mTileSize(0u) {
   init(info);
 }
 
@@ -19,18 +24,75 @@ const sf::Vector2u &TileMap::getMapSize() const { return mMapSize; }
 
 unsigned int TileMap::getTileSize() const { return mTileSize; }
 
+void TileMap::drawBackLayers(sf::RenderTarget &target,
+                             sf::RenderStates states) const {
+  for (const auto &batch : mBatches) {
+    if (batch.mDepth <= 0) {
+      drawBatch(batch, target, states);
+    }
+  }
+}
+
+void TileMap::drawFrontLayers(sf::RenderTarget &target,
+                              sf::RenderStates states) const {
+  for (const auto &batch : mBatches) {
+    if (batch.mDepth > 0) {
+      drawBatch(batch, target, states);
+    }
+  }
+}
+
 void TileMap::init(const TileMapInfo &info) {
-  mVertices.resize(info.mMapRectNum.x * info.mMapRectNum.y *
-                   RECTANGLE_VERTEX_NUM);
+  mChunkCount = {
+      (info.mMapRectNum.x + mChunkTileCount - 1u) / mChunkTileCount,
+      (info.mMapRectNum.y + mChunkTileCount - 1u) / mChunkTileCount};
+
+  // layers are appended in file order, so merged ones keep their overlap
+  for (const auto &layer : info.mLayers) {
+    addLayer(getBatchFor(layer), layer, info);
+  }
+
+  std::stable_sort(mBatches.begin(), mBatches.end(),
+                   [](const Batch &lhs, const Batch &rhs) {
+                     return lhs.mDepth < rhs.mDepth;
+                   });
+
+  mMapSize = info.mMapRectNum * info.mTileSize;
+  mTileSize = info.mTileSize;
+}
+
+TileMap::Batch &TileMap::getBatchFor(const TileLayerInfo &layer) {
+  // the map has a single tileset, so depth and parallax decide the batch
+  const auto it = std::find_if(mBatches.begin(), mBatches.end(),
+                               [&layer](const Batch &batch) {
+                                 return batch.mDepth == layer.mDepth &&
+                                        batch.mParallax == layer.mParallax;
+                               });
+
+  if (it != mBatches.end()) {
+    return *it;
+  }
+
+  mBatches.push_back({layer.mDepth, layer.mParallax,
+                      std::vector<sf::VertexArray>(
+                          mChunkCount.x * mChunkCount.y,
+                          sf::VertexArray{sf::Quads})});
 
-  const sf::Vector2u texRectNum = mTexture.getSize() / info.mTileSize;
+  return mBatches.back();
+}
+
+void TileMap::addLayer(Batch &batch, const TileLayerInfo &layer,
+                       const TileMapInfo &info) {
+  const sf::Vector2u texRectNum =
+      ResourceManager::getTextureSize(info.mTilesetTextureName) /
+      info.mTileSize;
   const unsigned int texRectLimit = texRectNum.x * texRectNum.y;
   const auto tileSize = static_cast<float>(info.mTileSize);
 
   for (unsigned int y = 0; y < info.mMapRectNum.y; y++) {
     for (unsigned int x = 0; x < info.mMapRectNum.x; x++) {
       const auto gidIndex = y * info.mMapRectNum.x + x;
-      const unsigned int gid = info.mGids.at(gidIndex);
+      const unsigned int gid = layer.mGids.at(gidIndex);
 
       // skip if there is no texture tile here
       if (gid < info.mFirstgid) {
@@ -44,7 +106,7 @@ void TileMap::init(const TileMapInfo &info) {
       const sf::Vector2f texOrigin{
           static_cast<float>(textureIndex % texRectNum.x),
           static_cast<float>(textureIndex / texRectNum.x)};
-      sf::Vertex *const quad = &mVertices[gidIndex * RECTANGLE_VERTEX_NUM];
+      sf::Vertex quad[RECTANGLE_VERTEX_NUM];
 
       quad[0].position = sf::Vector2f(x, y) * tileSize;
       quad[1].position = sf::Vector2f(x + 1, y) * tileSize;
@@ -56,14 +118,58 @@ void TileMap::init(const TileMapInfo &info) {
       quad[2].texCoords =
           sf::Vector2f(texOrigin.x + 1, texOrigin.y + 1) * tileSize;
       quad[3].texCoords = sf::Vector2f(texOrigin.x, texOrigin.y + 1) * tileSize;
+
+      const auto chunkX = x / mChunkTileCount;
+      const auto chunkY = y / mChunkTileCount;
+      auto &chunk = batch.mChunks[chunkY * mChunkCount.x + chunkX];
+
+      for (const auto &vertex : quad) {
+        chunk.append(vertex);
+      }
     }
   }
-
-  mMapSize = info.mMapRectNum * info.mTileSize;
-  mTileSize = info.mTileSize;
 }
 
-void TileMap::draw(sf::RenderTarget &target, sf::RenderStates states) const {
-  states.texture = &mTexture;
-  target.draw(mVertices, states);
+void TileMap::drawBatch(const Batch &batch, sf::RenderTarget &target,
+                        sf::RenderStates states) const {
+  if (batch.mChunks.empty()) {
+    return;
+  }
+
+  // the view is never rotated, its bounds are axis-aligned
+  const auto &view = target.getView();
+  const auto viewTopLeft = view.getCenter() - view.getSize() / 2.f;
+
+  // a layer with parallax below 1 lags behind the view, aligned with the
+  // level at the top left corner of the map
+  const sf::Vector2f offset = {viewTopLeft.x * (1.f - batch.mParallax.x),
+                               viewTopLeft.y * (1.f - batch.mParallax.y)};
+  const auto topLeft = viewTopLeft - offset;
+  const auto bottomRight = topLeft + view.getSize();
+  const auto chunkSize = static_cast<float>(mChunkTileCount * mTileSize);
+
+  const auto toChunk = [chunkSize](float pixels, unsigned int chunkCount) {
+    const auto chunk = std::floor(pixels / chunkSize);
+    const auto last = static_cast<float>(chunkCount - 1u);
+
+    return static_cast<unsigned int>(std::min(std::max(chunk, 0.f), last));
+  };
+
+  const auto firstX = toChunk(topLeft.x, mChunkCount.x);
+  const auto lastX = toChunk(bottomRight.x, mChunkCount.x);
+  const auto firstY = toChunk(topLeft.y, mChunkCount.y);
+  const auto lastY = toChunk(bottomRight.y, mChunkCount.y);
+
+  states.texture = mTexture.get();
+  states.transform.translate(offset);
+
+  for (unsigned int y = firstY; y <= lastY; y++) {
+    for (unsigned int x = firstX; x <= lastX; x++) {
+      const auto &chunk = batch.mChunks[y * mChunkCount.x + x];
+
+      if (chunk.getVertexCount() > 0) {
+        target.draw(chunk, states);
+      }
+    }
+  }
 }
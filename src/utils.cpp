@@ -3,6 +3,7 @@
 #include "utils.h"
 #include "animationType.h"
 #include "core.h"
+#include "fixtureData.h"
 #include "inputManager.h"
 #include "objectType.h"
 #include "stateType.h"
@@ -17,14 +18,24 @@
   case base::label:                                                            \
     return (#label)
 
-UserData *getFixtureUserData(const b2Fixture *const fixture) {
+FixtureData *getFixtureData(const b2Fixture *const fixture) {
   NOT_NULL(fixture);
 
-  UserData *userData = static_cast<UserData *>(fixture->GetUserData());
+  FixtureData *fixtureData =
+      static_cast<FixtureData *>(fixture->GetUserData());
+
+  NOT_NULL(fixtureData);
+
+  return fixtureData;
+}
 
-  NOT_NULL(userData);
+UserData *getFixtureUserData(const b2Fixture *const fixture) {
+  return &getFixtureData(fixture)->mUserData;
+}
 
-  return userData;
+void setFixtureUserData(const b2Fixture *const fixture,
+                        const UserData &userData) {
+  getFixtureData(fixture)->mUserData = userData;
 }
 
 unsigned int strToUintSave(const std::string &str, size_t *const pos,
@@ -151,6 +162,7 @@ const char *toString(ANIMATION_TYPE animationType) {
 
 const char *toString(STATE_TYPE stateType) {
   switch (stateType) {
+    DECLARE_CASE(STATE_TYPE, LOADING);
     DECLARE_CASE(STATE_TYPE, INTRO);
     DECLARE_CASE(STATE_TYPE, MENU);
     DECLARE_CASE(STATE_TYPE, SETTINGS);
@@ -0,0 +1,103 @@
+#define LOG_TAG "WorkerPool"
+
+#include "workerPool.h"
+#include "core.h"
+
+WorkerPool::WorkerPool(size_t threadCount)
+    : mChunkCount(threadCount + 1), mThreads(), mMutex(), mWorkReady(),
+      mWorkDone(), mFunction(nullptr), mCount(0), mNextChunk(mChunkCount),
+      mFinishedChunks(0), mGeneration(0), mStopping(false) {
+  mThreads.reserve(threadCount);
+
+  for (size_t i = 0; i < threadCount; i++) {
+    mThreads.emplace_back(&WorkerPool::workerLoop, this);
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mStopping = true;
+  }
+
+  mWorkReady.notify_all();
+
+  for (auto &thread : mThreads) {
+    thread.join();
+  }
+}
+
+size_t WorkerPool::getChunkCount() const { return mChunkCount; }
+
+void WorkerPool::parallelFor(size_t count, const ChunkFunction &function) {
+  CHECK(function);
+
+  if (count == 0) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    CHECK(mFunction == nullptr);
+
+    mFunction = &function;
+    mCount = count;
+    mFinishedChunks = 0;
+    mGeneration++;
+    mNextChunk.store(0);
+  }
+
+  mWorkReady.notify_all();
+  runChunks();
+
+  std::unique_lock<std::mutex> lock{mMutex};
+  mWorkDone.wait(lock, [this] { return mFinishedChunks == mChunkCount; });
+  mFunction = nullptr;
+}
+
+size_t WorkerPool::getDefaultThreadCount() {
+  const size_t hardwareThreads = std::thread::hardware_concurrency();
+
+  return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void WorkerPool::workerLoop() {
+  size_t generation = 0;
+
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock{mMutex};
+      mWorkReady.wait(lock, [this, generation] {
+        return mStopping || mGeneration != generation;
+      });
+
+      if (mStopping) {
+        return;
+      }
+
+      generation = mGeneration;
+    }
+
+    runChunks();
+  }
+}
+
+void WorkerPool::runChunks() {
+  // a late worker finds the counter past the end and does nothing
+  for (size_t chunk = mNextChunk++; chunk < mChunkCount;
+       chunk = mNextChunk++) {
+    const size_t begin = mCount * chunk / mChunkCount;
+    const size_t end = mCount * (chunk + 1) / mChunkCount;
+
+    if (begin < end) {
+      (*mFunction)(chunk, begin, end);
+    }
+
+    std::lock_guard<std::mutex> lock{mMutex};
+
+    if (++mFinishedChunks == mChunkCount) {
+      mWorkDone.notify_one();
+    }
+  }
+}
@@ -3,105 +3,241 @@
 #include "world.h"
 #include "animationManager.h"
 #include "archer.h"
+#include "backgroundThread.h"
 #include "bullet.h"
+#include "bulletPool.h"
+#include "commandBuffer.h"
 #include "core.h"
+#include "inputManager.h"
 #include "levelParser.h"
 #include "objectType.h"
 #include "physicalBody.h"
 #include "physicalWorld.h"
 #include "platform.h"
 #include "player.h"
+#include "profiler.h"
 #include "resourceManager.h"
 #include "runner.h"
 #include "soundPlayer.h"
 #include "tileMap.h"
 #include "utils.h"
+#include "workerPool.h"
+#include "worldSnapshot.h"
 
-#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Sprite.hpp>
 
 #include <algorithm>
 
-const sf::Vector2f World::mBulletSize = {10.f, 10.f};
+const size_t World::mBulletPoolPrewarmCount = 8u;
+const size_t World::mBulletPoolCapacity = 64u;
+const float World::mDefaultSimulationMargin = 320.f;
+const size_t World::mParallelUpdateThreshold = 64u;
 
 World::World(size_t currentLevel)
-    : mPhysicalWorld(), mPlayer(), mEntities(),
-      mView(ResourceManager::getWindow().getDefaultView()), mTileMap(),
-      mBackground(makeUnique<sf::Sprite>(
-          ResourceManager::getLevelTexture(currentLevel))) {
-  initPhysics(currentLevel);
+    : World(ResourceManager::getLevelParser(currentLevel),
+            ResourceManager::getLevelTexture(currentLevel)) {
+  for (const auto &filename : ResourceManager::getLevelManifest(currentLevel)) {
+    mResidentTextures.push_back(ResourceManager::acquireTexture(filename));
+  }
+
+  InputManager::beginLevel(currentLevel);
 }
 
-World::~World() {}
+World::World(const LevelParser &levelParser, const TextureHandle &background)
+    : mPhysicalWorld(), mBulletPool(), mPlayer(), mEntities(), mBullets(),
+      mWorkerPool(makeUnique<WorkerPool>(WorkerPool::getDefaultThreadCount())),
+      mCommandBuffers(), mSimulatedEntities(),
+      mView(sf::FloatRect{0.f, 0.f, static_cast<float>(WINDOW_WIDTH),
+                          static_cast<float>(WINDOW_HEIGHT)}),
+      mPreviousViewCenter(), mInterpolation(1.f),
+      mSimulationMargin(mDefaultSimulationMargin), mTileMap(),
+      mResidentTextures{background},
+      mBackground(),
+      mFrontSnapshot(makeUnique<WorldSnapshot>()),
+      mBackSnapshot(makeUnique<WorldSnapshot>()), mHasBackSnapshot(false),
+      mPipelined(false), mDebugDraw(false),
+      mTickThread(makeUnique<BackgroundThread>()) {
+  for (size_t i = 0; i < mWorkerPool->getChunkCount(); i++) {
+    mCommandBuffers.push_back(makeUnique<CommandBuffer>());
+  }
+
+  // headless worlds are never drawn and get no texture
+  if (background != nullptr) {
+    mBackground = makeUnique<sf::Sprite>(*background);
+  }
+
+  initPhysics(levelParser);
+  updateView();
+  updateSimulationRegion();
+  savePreviousState();
+  captureSnapshot();
+  finishTick();
+}
+
+World::~World() { waitForTick(); }
 
 void World::update(sf::Time dt) {
-  for (const auto &entity : mEntities) {
-    entity->handleRealtimeInput();
+  finishTick();
+
+  // the keyboard is read on the thread owning the window
+  InputManager::tick();
+
+  if (mPipelined) {
+    mTickThread->run([this, dt] { simulate(dt); });
+  } else {
+    simulate(dt);
+    finishTick();
   }
+}
 
-  mPlayer->handleRealtimeInput();
+void World::setPipelined(bool pipelined) {
+  finishTick();
+
+  mPipelined = pipelined;
+}
 
-  mPhysicalWorld->update(dt);
+void World::simulate(sf::Time dt) {
+  PROFILE_SCOPE("World::update");
 
-  const auto &playerPosition = mPlayer->getPosition();
+  savePreviousState();
 
   for (const auto &entity : mEntities) {
-    if (entity->getType() == OBJECT_TYPE::ARCHER) {
-      const auto &entityPosition = entity->getPosition();
-      const auto newHeading =
-          entityPosition.x < playerPosition.x ? HEADING::RIGHT : HEADING::LEFT;
-      entity->setHeading(newHeading);
+    if (entity->isSimulated()) {
+      entity->handleRealtimeInput();
     }
+  }
+
+  mPlayer->handleRealtimeInput();
+
+  {
+    PROFILE_SCOPE("PhysicalWorld::update");
 
-    entity->update(dt);
+    mPhysicalWorld->update(dt);
   }
 
-  mPlayer->update(dt);
+  {
+    PROFILE_SCOPE("Entity::update");
+
+    updateEntities(dt);
+    applyCommands();
+
+    // bullets touch the broadphase when they explode, so they stay serial
+    for (const auto &bullet : mBullets) {
+      bullet->update(dt);
+    }
+
+    mPlayer->update(dt);
+  }
 
   mEntities.remove_if([](const std::unique_ptr<Entity> &entity) {
     return entity->isDestroyed();
   });
 
+  for (auto it = mBullets.begin(); it != mBullets.end();) {
+    if ((*it)->isDestroyed()) {
+      mBulletPool->release(std::move(*it));
+      it = mBullets.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
   updateView();
+  updateSimulationRegion();
   updateSoundListener();
+  captureSnapshot();
+}
+
+void World::toggleDebugDraw() { mDebugDraw = !mDebugDraw; }
+
+void World::setInterpolation(float interpolation) {
+  CHECK(interpolation >= 0.f && interpolation <= 1.f);
+
+  mInterpolation = interpolation;
+}
+
+bool World::failed() const { return mFrontSnapshot->failed(); }
+
+bool World::success() const { return mFrontSnapshot->success(); }
+
+void World::setSimulationMargin(float margin) {
+  CHECK(margin >= 0.f);
+
+  waitForTick();
+
+  mSimulationMargin = margin;
+  updateSimulationRegion();
+}
+
+size_t World::getEntityCount() const {
+  waitForTick();
+
+  return mEntities.size() + mBullets.size();
 }
 
-bool World::failed() const {
-  CHECK(mPlayer != nullptr);
+size_t World::getSimulatedEntityCount() const {
+  waitForTick();
 
-  return mPlayer->isDestroyed();
+  const auto simulatedCount =
+      std::count_if(mEntities.cbegin(), mEntities.cend(),
+                    [](const std::unique_ptr<Entity> &entity) {
+                      return entity->isSimulated();
+                    });
+
+  return static_cast<size_t>(simulatedCount) + mBullets.size();
 }
 
-bool World::success() const { return mPhysicalWorld->finished(); }
+size_t World::getDrawnEntityCount() const {
+  // the front snapshot is not touched by the tick
+  return mFrontSnapshot->getDrawnEntityCount();
+}
+
+const PhysicalWorld &World::getPhysicalWorld() const {
+  waitForTick();
+  NOT_NULL(mPhysicalWorld);
+
+  return *mPhysicalWorld;
+}
+
+const BulletPool &World::getBulletPool() const {
+  waitForTick();
+  NOT_NULL(mBulletPool);
+
+  return *mBulletPool;
+}
 
 void World::onSpawnBullet(HEADING heading, OBJECT_TYPE type,
                           const sf::Vector2f &position) {
   CHECK(type == OBJECT_TYPE::ALLIED_BULLET ||
         type == OBJECT_TYPE::ENEMY_BULLET);
 
-  const sf::FloatRect bounds = {position, mBulletSize};
-  auto body = makeUnique<PhysicalBody>(*mPhysicalWorld, bounds, type);
-  auto bullet = makeUnique<Bullet>(heading, std::move(body));
-
-  mEntities.push_back(std::move(bullet));
+  mBullets.push_back(mBulletPool->acquire(type, heading, position));
 
   const std::string soundFile =
       type == OBJECT_TYPE::ALLIED_BULLET ? "PlayerShot.wav" : "EnemyShot.wav";
   SoundPlayer::play(soundFile, position);
 }
 
-void World::initPhysics(size_t currentLevel) {
-  const auto &levelParser = ResourceManager::getLevelParser(currentLevel);
+void World::initPhysics(const LevelParser &levelParser) {
   mTileMap = makeUnique<TileMap>(levelParser.getTileMapInfo());
 
   PhysicalBodyMap entityBodyMap;
   mPhysicalWorld = makeUnique<PhysicalWorld>(levelParser, entityBodyMap);
+  mBulletPool = makeUnique<BulletPool>(
+      *mPhysicalWorld, mBulletPoolPrewarmCount, mBulletPoolCapacity);
 
   const Shooter::BulletSpawnCallback shooterCallback =
       [this](HEADING heading, OBJECT_TYPE type, const sf::Vector2f &position) {
         onSpawnBullet(heading, type, position);
       };
 
+  // enemies are updated in parallel, their bullets wait for applyCommands
+  const Shooter::BulletSpawnCallback deferredShooterCallback =
+      [](HEADING heading, OBJECT_TYPE type, const sf::Vector2f &position) {
+        CommandBuffer::getCurrent().spawnBullet(heading, type, position);
+      };
+
   for (auto &pair : entityBodyMap) {
     auto &bodies = pair.second;
 
@@ -136,7 +272,7 @@ void World::initPhysics(size_t currentLevel) {
     case OBJECT_TYPE::ARCHER: {
       for (auto &body : bodies) {
         auto archer = makeUnique<Archer>(std::move(body));
-        archer->setBulletSpawnCallback(shooterCallback);
+        archer->setBulletSpawnCallback(deferredShooterCallback);
 
         mEntities.push_back(std::move(archer));
       }
@@ -150,6 +286,100 @@ void World::initPhysics(size_t currentLevel) {
   }
 }
 
+void World::waitForTick() const { mTickThread->wait(); }
+
+void World::finishTick() {
+  waitForTick();
+
+  if (mHasBackSnapshot) {
+    mFrontSnapshot.swap(mBackSnapshot);
+    mHasBackSnapshot = false;
+  }
+}
+
+void World::captureSnapshot() {
+  PROFILE_SCOPE("World::captureSnapshot");
+
+  mBackSnapshot->clear();
+
+  for (const auto &entity : mEntities) {
+    if (entity->isSimulated()) {
+      mBackSnapshot->addEntity(*entity, DRAW_LAYER::ENTITIES);
+    }
+  }
+
+  for (const auto &bullet : mBullets) {
+    mBackSnapshot->addEntity(*bullet, DRAW_LAYER::BULLETS);
+  }
+
+  mBackSnapshot->addEntity(*mPlayer, DRAW_LAYER::PLAYER);
+  mBackSnapshot->setViewCenter(mPreviousViewCenter, mView.getCenter());
+  mBackSnapshot->setOutcome(mPlayer->isDestroyed(), mPhysicalWorld->finished());
+
+  mHasBackSnapshot = true;
+}
+
+void World::updateEntities(sf::Time dt) {
+  mSimulatedEntities.clear();
+
+  for (const auto &entity : mEntities) {
+    if (entity->isSimulated()) {
+      mSimulatedEntities.push_back(entity.get());
+    }
+  }
+
+  // touches only the entity itself and its body, other bodies are only read
+  const WorkerPool::ChunkFunction updateChunk =
+      [this, dt](size_t chunk, size_t begin, size_t end) {
+        PROFILE_SCOPE("World::updateEntities chunk");
+
+        const CommandBuffer::Binding binding{*mCommandBuffers[chunk]};
+
+        for (size_t i = begin; i < end; i++) {
+          mSimulatedEntities[i]->update(dt);
+        }
+      };
+
+  // waking the workers costs more than a few entities
+  if (mSimulatedEntities.size() < mParallelUpdateThreshold) {
+    updateChunk(0, 0, mSimulatedEntities.size());
+  } else {
+    mWorkerPool->parallelFor(mSimulatedEntities.size(), updateChunk);
+  }
+}
+
+void World::applyCommands() {
+  for (const auto &buffer : mCommandBuffers) {
+    for (const auto &command : buffer->getCommands()) {
+      switch (command.mType) {
+      case CommandBuffer::COMMAND_TYPE::SPAWN_BULLET: {
+        onSpawnBullet(command.mHeading, command.mObjectType,
+                      command.mPosition);
+        break;
+      }
+      default: {
+        CHECK(false);
+      }
+      }
+    }
+
+    buffer->clear();
+  }
+}
+
+void World::savePreviousState() {
+  for (const auto &entity : mEntities) {
+    entity->savePreviousPosition();
+  }
+
+  for (const auto &bullet : mBullets) {
+    bullet->savePreviousPosition();
+  }
+
+  mPlayer->savePreviousPosition();
+  mPreviousViewCenter = mView.getCenter();
+}
+
 void World::updateView() {
   const auto mapSize = static_cast<sf::Vector2f>(mTileMap->getMapSize());
   const auto viewhalfSize = mView.getSize() / 2.f;
@@ -165,21 +395,44 @@ void World::updateView() {
   mView.setCenter(newViewCenter);
 }
 
+void World::updateSimulationRegion() {
+  const auto halfSize = mView.getSize() / 2.f + sf::Vector2f{mSimulationMargin,
+                                                             mSimulationMargin};
+  const auto topLeft = mView.getCenter() - halfSize;
+  const sf::FloatRect region = {topLeft, halfSize * 2.f};
+
+  // bullets are short-lived and always simulated
+  for (const auto &entity : mEntities) {
+    entity->setSimulated(region.contains(entity->getPosition()));
+  }
+}
+
 void World::updateSoundListener() {
   SoundPlayer::setListenerPosition(mPlayer->getPosition());
 }
 
 void World::draw(sf::RenderTarget &target, sf::RenderStates states) const {
-  target.setView(mView);
+  PROFILE_SCOPE("World::draw");
 
-  target.draw(*mBackground, states);
-  target.draw(*mTileMap, states);
+  // only the front snapshot and the immutable level are read here,
+  // a pipelined tick may be running meanwhile
+  const sf::View view{mFrontSnapshot->getViewCenter(mInterpolation),
+                      mView.getSize()};
 
-  for (const auto &entity : mEntities) {
-    target.draw(*entity, states);
+  target.setView(view);
+
+  if (mBackground != nullptr) {
+    target.draw(*mBackground, states);
   }
+  mTileMap->drawBackLayers(target, states);
+
+  mFrontSnapshot->drawEntities(target, states, mInterpolation);
 
-  target.draw(*mPlayer, states);
+  mTileMap->drawFrontLayers(target, states);
 
-  // target.draw(*mPhysicalWorld, states);
+  if (mDebugDraw) {
+    // bodies are read directly, not from the snapshot
+    waitForTick();
+    target.draw(*mPhysicalWorld, states);
+  }
 }
@@ -0,0 +1,81 @@
+#define LOG_TAG "WorldSnapshot"
+
+#include "worldSnapshot.h"
+#include "core.h"
+#include "entity.h"
+#include "spriteBatch.h"
+#include "utils.h"
+
+#include <SFML/Graphics/RenderTarget.hpp>
+
+WorldSnapshot::WorldSnapshot()
+    : mEntities(), mPreviousViewCenter(), mViewCenter(), mFailed(false),
+      mSuccess(false), mBatch(makeUnique<SpriteBatch>()),
+      mDrawnEntityCount(0u) {}
+
+WorldSnapshot::~WorldSnapshot() {}
+
+void WorldSnapshot::clear() { mEntities.clear(); }
+
+void WorldSnapshot::addEntity(const Entity &entity, DRAW_LAYER layer) {
+  const auto transform = entity.getRenderTransform();
+
+  mEntities.push_back({entity.getTexture(), entity.getTextureRect(), layer,
+                       transform,
+                       transform.transformRect(entity.getBoundingRect()),
+                       entity.getInterpolationOffset(0.f)});
+}
+
+void WorldSnapshot::setViewCenter(const sf::Vector2f &previous,
+                                  const sf::Vector2f &current) {
+  mPreviousViewCenter = previous;
+  mViewCenter = current;
+}
+
+void WorldSnapshot::setOutcome(bool failed, bool success) {
+  mFailed = failed;
+  mSuccess = success;
+}
+
+sf::Vector2f WorldSnapshot::getViewCenter(float interpolation) const {
+  return interpolate(mPreviousViewCenter, mViewCenter, interpolation);
+}
+
+bool WorldSnapshot::failed() const { return mFailed; }
+
+bool WorldSnapshot::success() const { return mSuccess; }
+
+void WorldSnapshot::drawEntities(sf::RenderTarget &target,
+                                 sf::RenderStates states,
+                                 float interpolation) const {
+  mBatch->clear();
+  mDrawnEntityCount = 0u;
+
+  const auto &view = target.getView();
+  const sf::FloatRect visibleRect = {view.getCenter() - view.getSize() / 2.f,
+                                     view.getSize()};
+
+  for (const auto &entity : mEntities) {
+    const auto offset = entity.mPreviousOffset * (1.f - interpolation);
+
+    sf::FloatRect bounds = entity.mBounds;
+    bounds.left += offset.x;
+    bounds.top += offset.y;
+
+    if (!visibleRect.intersects(bounds)) {
+      continue;
+    }
+
+    sf::Transform transform;
+    transform.translate(offset);
+    transform *= entity.mTransform;
+
+    mBatch->add(*entity.mTexture, entity.mTextureRect, transform,
+                static_cast<size_t>(entity.mLayer));
+    mDrawnEntityCount++;
+  }
+
+  mBatch->render(target, states);
+}
+
+size_t WorldSnapshot::getDrawnEntityCount() const { return mDrawnEntityCount; }
@@ -0,0 +1,363 @@
+#define LOG_TAG "AtlasPacker"
+
+#include "core.h"
+#include "utils.h"
+
+#include "tinyxml.h"
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// Packs the frames cut from the entity sprite sheets into shared atlas
+// textures, so that entities drawn by one SpriteBatch share a texture:
+// Platformer_atlas [--max-size N] [--padding N]
+// Run from the directory containing Media. Atlas pages are written to the
+// textures directory, the entity descriptions with frames in atlas
+// coordinates to the Atlas subdirectory of the entities one, where
+// AnimationParser prefers them over the original ones.
+namespace {
+const std::string ENTITY_FILE_EXTENSION = ".xml";
+const std::string ATLAS_PAGE_PREFIX = "Atlas_";
+const std::string ATLAS_PAGE_EXTENSION = ".png";
+
+struct PackerOptions {
+  unsigned int mMaxSize = 2048u;
+
+  // transparent pixels between frames, keeps filtering from bleeding
+  unsigned int mPadding = 1u;
+};
+
+// source image and frame rectangle
+using FrameKey = std::tuple<std::string, int, int, int, int>;
+
+struct Page {
+  unsigned int mWidth = 0u;
+  unsigned int mHeight = 0u;
+
+  // frames are placed left to right on shelves
+  unsigned int mShelfX = 0u;
+  unsigned int mShelfY = 0u;
+  unsigned int mShelfHeight = 0u;
+
+  std::map<FrameKey, sf::Vector2u> mFrames;
+};
+
+struct EntityFile {
+  std::string mName;
+  std::string mImage;
+  std::unique_ptr<TiXmlDocument> mDocument;
+  std::vector<FrameKey> mFrames;
+  size_t mPage = 0u;
+};
+
+class AtlasPacker {
+public:
+  explicit AtlasPacker(const PackerOptions &options);
+
+  void load();
+  void pack();
+  void save() const;
+
+private:
+  PackerOptions mOptions;
+
+  std::vector<EntityFile> mFiles;
+  std::vector<Page> mPages;
+
+  void loadFile(const std::string &name);
+
+  // all frames of a file go to one page, its image attribute names one
+  bool placeFrames(Page &page, const std::vector<FrameKey> &frames) const;
+  bool placeFrame(Page &page, const FrameKey &frame) const;
+
+  std::string getPageName(size_t page) const;
+
+  void savePage(size_t page) const;
+  void saveFile(const EntityFile &file) const;
+};
+
+AtlasPacker::AtlasPacker(const PackerOptions &options)
+    : mOptions(options), mFiles(), mPages() {
+  CHECK(mOptions.mMaxSize > 0u);
+}
+
+void AtlasPacker::load() {
+  for (const auto &name : listDirectory(ENTITIES_DIR)) {
+    const auto extensionSize = ENTITY_FILE_EXTENSION.size();
+
+    if (name.size() > extensionSize &&
+        name.compare(name.size() - extensionSize, extensionSize,
+                     ENTITY_FILE_EXTENSION) == 0) {
+      loadFile(name);
+    }
+  }
+
+  CHECK(!mFiles.empty());
+
+  LOG("%zu entity files loaded", mFiles.size());
+}
+
+void AtlasPacker::pack() {
+  // the tallest frames go first, they decide the height of the shelves
+  std::sort(mFiles.begin(), mFiles.end(),
+            [](const EntityFile &lhs, const EntityFile &rhs) {
+              return std::get<4>(lhs.mFrames.front()) >
+                     std::get<4>(rhs.mFrames.front());
+            });
+
+  for (auto &file : mFiles) {
+    // the first page with room for the file takes its frames
+    auto it = std::find_if(mPages.begin(), mPages.end(),
+                           [this, &file](Page &page) {
+                             return placeFrames(page, file.mFrames);
+                           });
+
+    if (it == mPages.end()) {
+      mPages.emplace_back();
+      it = mPages.end() - 1;
+
+      CHECK(placeFrames(*it, file.mFrames));
+    }
+
+    file.mPage = static_cast<size_t>(it - mPages.begin());
+  }
+
+  for (size_t i = 0; i < mPages.size(); i++) {
+    LOG("%s: %ux%u, %zu frames", getPageName(i).c_str(), mPages[i].mWidth,
+        mPages[i].mHeight, mPages[i].mFrames.size());
+  }
+}
+
+void AtlasPacker::save() const {
+  for (size_t i = 0; i < mPages.size(); i++) {
+    savePage(i);
+  }
+
+  if (mkdir(ATLAS_ENTITIES_DIR.c_str(), 0755) != 0) {
+    CHECK(errno == EEXIST);
+  }
+
+  for (const auto &file : mFiles) {
+    saveFile(file);
+  }
+
+  LOG("entity files saved to %s", ATLAS_ENTITIES_DIR.c_str());
+}
+
+void AtlasPacker::loadFile(const std::string &name) {
+  mFiles.emplace_back();
+
+  auto &file = mFiles.back();
+  file.mName = name;
+  file.mDocument = makeUnique<TiXmlDocument>();
+
+  CHECK(file.mDocument->LoadFile(ENTITIES_DIR + name));
+
+  const TiXmlElement *const spritesElem =
+      file.mDocument->FirstChildElement("sprites");
+
+  NOT_NULL(spritesElem);
+
+  const std::string *const image = spritesElem->Attribute(std::string{"image"});
+
+  NOT_NULL(image);
+
+  file.mImage = *image;
+
+  for (const TiXmlElement *animationElem = spritesElem->FirstChildElement();
+       animationElem != nullptr;
+       animationElem = animationElem->NextSiblingElement()) {
+    for (const TiXmlElement *cutElem = animationElem->FirstChildElement();
+         cutElem != nullptr; cutElem = cutElem->NextSiblingElement()) {
+      int x, y, width, height;
+
+      CHECK(cutElem->QueryIntAttribute("x", &x) == TIXML_SUCCESS);
+      CHECK(cutElem->QueryIntAttribute("y", &y) == TIXML_SUCCESS);
+      CHECK(cutElem->QueryIntAttribute("w", &width) == TIXML_SUCCESS);
+      CHECK(cutElem->QueryIntAttribute("h", &height) == TIXML_SUCCESS);
+      CHECK(width > 0 && height > 0);
+
+      file.mFrames.emplace_back(file.mImage, x, y, width, height);
+    }
+  }
+
+  CHECK(!file.mFrames.empty());
+
+  std::sort(file.mFrames.begin(), file.mFrames.end(),
+            [](const FrameKey &lhs, const FrameKey &rhs) {
+              if (std::get<4>(lhs) != std::get<4>(rhs)) {
+                return std::get<4>(lhs) > std::get<4>(rhs);
+              }
+
+              return lhs < rhs;
+            });
+  file.mFrames.erase(std::unique(file.mFrames.begin(), file.mFrames.end()),
+                     file.mFrames.end());
+}
+
+bool AtlasPacker::placeFrames(Page &page,
+                              const std::vector<FrameKey> &frames) const {
+  Page result = page;
+
+  for (const auto &frame : frames) {
+    if (!placeFrame(result, frame)) {
+      return false;
+    }
+  }
+
+  page = std::move(result);
+
+  return true;
+}
+
+bool AtlasPacker::placeFrame(Page &page, const FrameKey &frame) const {
+  // frames shared by several files are stored once
+  if (page.mFrames.find(frame) != page.mFrames.cend()) {
+    return true;
+  }
+
+  const auto width = static_cast<unsigned int>(std::get<3>(frame));
+  const auto height = static_cast<unsigned int>(std::get<4>(frame));
+
+  CHECK(width <= mOptions.mMaxSize && height <= mOptions.mMaxSize);
+
+  if (page.mShelfX + width > mOptions.mMaxSize) {
+    page.mShelfY += page.mShelfHeight + mOptions.mPadding;
+    page.mShelfX = 0u;
+    page.mShelfHeight = 0u;
+  }
+
+  if (page.mShelfY + height > mOptions.mMaxSize) {
+    return false;
+  }
+
+  page.mFrames.emplace(frame, sf::Vector2u{page.mShelfX, page.mShelfY});
+
+  page.mWidth = std::max(page.mWidth, page.mShelfX + width);
+  page.mHeight = std::max(page.mHeight, page.mShelfY + height);
+  page.mShelfX += width + mOptions.mPadding;
+  page.mShelfHeight = std::max(page.mShelfHeight, height);
+
+  return true;
+}
+
+std::string AtlasPacker::getPageName(size_t page) const {
+  return ATLAS_PAGE_PREFIX + std::to_string(page) + ATLAS_PAGE_EXTENSION;
+}
+
+void AtlasPacker::savePage(size_t pageIndex) const {
+  const auto &page = mPages[pageIndex];
+
+  sf::Image atlas;
+  atlas.create(page.mWidth, page.mHeight, sf::Color::Transparent);
+
+  std::map<std::string, sf::Image> images;
+
+  for (const auto &pair : page.mFrames) {
+    const auto &frame = pair.first;
+    const auto &imageName = std::get<0>(frame);
+
+    auto it = images.find(imageName);
+
+    if (it == images.end()) {
+      it = images.emplace(imageName, sf::Image{}).first;
+
+      CHECK(it->second.loadFromFile(TEXTURES_DIR + imageName));
+    }
+
+    const sf::IntRect sourceRect = {std::get<1>(frame), std::get<2>(frame),
+                                    std::get<3>(frame), std::get<4>(frame)};
+
+    atlas.copy(it->second, pair.second.x, pair.second.y, sourceRect);
+  }
+
+  CHECK(atlas.saveToFile(TEXTURES_DIR + getPageName(pageIndex)));
+}
+
+void AtlasPacker::saveFile(const EntityFile &file) const {
+  const auto &page = mPages[file.mPage];
+
+  // the original document is kept, only the image and the cuts change
+  TiXmlDocument document = *file.mDocument;
+  TiXmlElement *const spritesElem = document.FirstChildElement("sprites");
+
+  NOT_NULL(spritesElem);
+
+  spritesElem->SetAttribute("image", getPageName(file.mPage));
+
+  for (TiXmlElement *animationElem = spritesElem->FirstChildElement();
+       animationElem != nullptr;
+       animationElem = animationElem->NextSiblingElement()) {
+    for (TiXmlElement *cutElem = animationElem->FirstChildElement();
+         cutElem != nullptr; cutElem = cutElem->NextSiblingElement()) {
+      int x, y, width, height;
+
+      CHECK(cutElem->QueryIntAttribute("x", &x) == TIXML_SUCCESS);
+      CHECK(cutElem->QueryIntAttribute("y", &y) == TIXML_SUCCESS);
+      CHECK(cutElem->QueryIntAttribute("w", &width) == TIXML_SUCCESS);
+      CHECK(cutElem->QueryIntAttribute("h", &height) == TIXML_SUCCESS);
+
+      const auto it =
+          page.mFrames.find(FrameKey{file.mImage, x, y, width, height});
+
+      CHECK(it != page.mFrames.cend());
+
+      cutElem->SetAttribute("x", static_cast<int>(it->second.x));
+      cutElem->SetAttribute("y", static_cast<int>(it->second.y));
+    }
+  }
+
+  CHECK(document.SaveFile(ATLAS_ENTITIES_DIR + file.mName));
+}
+
+unsigned int toUint(const char *const str) {
+  NOT_NULL(str);
+
+  const std::string copy = str;
+  size_t pos = 0;
+  const auto value = std::stoul(copy, &pos);
+
+  CHECK(pos == copy.size());
+
+  return static_cast<unsigned int>(value);
+}
+
+const char *nextArgument(int argc, char **argv, int &index) {
+  CHECK(index + 1 < argc);
+
+  return argv[++index];
+}
+} // unnamed namespace
+
+int main(int argc, char **argv) {
+  PackerOptions options;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+
+    if (argument == "--max-size") {
+      options.mMaxSize = toUint(nextArgument(argc, argv, i));
+    } else if (argument == "--padding") {
+      options.mPadding = toUint(nextArgument(argc, argv, i));
+    } else {
+      LOG("unknown argument: %s", argument.c_str());
+      CHECK(false);
+    }
+  }
+
+  AtlasPacker packer{options};
+  packer.load();
+  packer.pack();
+  packer.save();
+
+  return 0;
+}
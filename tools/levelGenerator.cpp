@@ -0,0 +1,404 @@
+#define LOG_TAG "LevelGenerator"
+
+#include "core.h"
+
+#include "tinyxml.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Writes a TMX level in the format accepted by LevelParser, with a
+// configurable map size and amount of objects, for scaling tests:
+// Platformer_levelgen --output FILE [--width N] [--height N] [--seed N]
+//                     [--tile-density F] [--enemies N] [--archers N]
+//                     [--horizontal-platforms N] [--vertical-platforms N]
+//                     [--ladders N] [--slopes N] [--hazards N]
+namespace {
+const unsigned int TILE_SIZE = 32u;
+const unsigned int FLOOR_SPACING = 6u;
+const unsigned int FLOOR_SEGMENT_TILES = 16u;
+const unsigned int WALL_GID = 5u;
+const unsigned int FLOOR_GID = 40u;
+const unsigned int MAX_GID = 64u;
+const unsigned int TILESET_TEXTURE_SIZE = 256u;
+const std::string TILESET_SOURCE = "Media/Textures/Tiles.png";
+
+struct ObjectSize {
+  const char *mName;
+  float mWidth;
+  float mHeight;
+};
+
+// sizes of the objects in the shipped levels
+const ObjectSize PLAYER = {"player", 20.f, 27.f};
+const ObjectSize FINISH = {"finish", 10.f, 32.f};
+const ObjectSize ENEMY = {"enemy", 48.f, 50.f};
+const ObjectSize ARCHER = {"archer", 77.f, 44.f};
+const ObjectSize HORIZONTAL_PLATFORM = {"HorizontalPlatform", 96.f, 11.f};
+const ObjectSize VERTICAL_PLATFORM = {"VerticalPlatform", 96.f, 11.f};
+const ObjectSize LADDER = {"ladder", 32.f, 64.f};
+const ObjectSize SLOPE_LEFT = {"SlopeLeft", 128.f, 62.f};
+const ObjectSize SLOPE_RIGHT = {"SlopeRight", 128.f, 62.f};
+const ObjectSize HAZARD = {"hazard", 128.f, 24.f};
+
+struct GeneratorOptions {
+  std::string mOutputFile;
+  unsigned int mWidth = 120u;
+  unsigned int mHeight = 60u;
+  unsigned int mSeed = 1u;
+  float mTileDensity = 0.05f;
+  unsigned int mEnemies = 10u;
+  unsigned int mArchers = 5u;
+  unsigned int mHorizontalPlatforms = 5u;
+  unsigned int mVerticalPlatforms = 5u;
+  unsigned int mLadders = 5u;
+  unsigned int mSlopes = 5u;
+  unsigned int mHazards = 5u;
+};
+
+struct Object {
+  const char *mName;
+  float mX;
+  float mY;
+  float mWidth;
+  float mHeight;
+};
+
+using CountOption = std::pair<std::string, unsigned int GeneratorOptions::*>;
+
+class LevelGenerator {
+public:
+  explicit LevelGenerator(const GeneratorOptions &options);
+
+  void generate();
+  void save() const;
+
+private:
+  GeneratorOptions mOptions;
+  std::mt19937 mRandom;
+
+  std::vector<unsigned int> mGids;
+  std::vector<Object> mObjects;
+
+  unsigned int getFloorCount() const;
+  float getFloorTop(unsigned int floor) const;
+
+  void generateTiles();
+  void generateGeometry();
+  void placeOnFloors(const ObjectSize &size, unsigned int count);
+  void placeBetweenFloors(const ObjectSize &size, unsigned int count);
+
+  float randomX(float width);
+  unsigned int randomFloor();
+};
+
+LevelGenerator::LevelGenerator(const GeneratorOptions &options)
+    : mOptions(options), mRandom(options.mSeed), mGids(), mObjects() {
+  CHECK(!mOptions.mOutputFile.empty());
+  CHECK(mOptions.mWidth >= FLOOR_SEGMENT_TILES);
+  CHECK(mOptions.mHeight >= 2u * FLOOR_SPACING);
+  CHECK(mOptions.mTileDensity >= 0.f && mOptions.mTileDensity <= 1.f);
+}
+
+void LevelGenerator::generate() {
+  generateTiles();
+  generateGeometry();
+
+  const auto lowestFloor = getFloorCount() - 1;
+  const auto mapWidth = static_cast<float>(mOptions.mWidth * TILE_SIZE);
+
+  mObjects.push_back({PLAYER.mName, 2.f * TILE_SIZE,
+                      getFloorTop(lowestFloor) - PLAYER.mHeight,
+                      PLAYER.mWidth, PLAYER.mHeight});
+  mObjects.push_back({FINISH.mName, mapWidth - 2.f * TILE_SIZE,
+                      getFloorTop(lowestFloor) - FINISH.mHeight,
+                      FINISH.mWidth, FINISH.mHeight});
+
+  placeOnFloors(ENEMY, mOptions.mEnemies);
+  placeOnFloors(ARCHER, mOptions.mArchers);
+  placeOnFloors(LADDER, mOptions.mLadders);
+  placeOnFloors(HAZARD, mOptions.mHazards);
+  placeOnFloors(SLOPE_LEFT, mOptions.mSlopes / 2);
+  placeOnFloors(SLOPE_RIGHT, mOptions.mSlopes - mOptions.mSlopes / 2);
+  placeBetweenFloors(HORIZONTAL_PLATFORM, mOptions.mHorizontalPlatforms);
+  placeBetweenFloors(VERTICAL_PLATFORM, mOptions.mVerticalPlatforms);
+
+  LOG("%zu objects on %u floors", mObjects.size(), getFloorCount());
+}
+
+void LevelGenerator::save() const {
+  TiXmlDocument doc;
+  TiXmlDeclaration *const declarationElem{
+      new (std::nothrow) TiXmlDeclaration{"1.0", "UTF-8", ""}};
+
+  NOT_NULL(declarationElem);
+  NOT_NULL(doc.LinkEndChild(declarationElem));
+
+  TiXmlElement *const mapElem{new (std::nothrow) TiXmlElement{"map"}};
+
+  NOT_NULL(mapElem);
+
+  mapElem->SetAttribute("version", "1.2");
+  mapElem->SetAttribute("orientation", "orthogonal");
+  mapElem->SetAttribute("renderorder", "right-down");
+  mapElem->SetAttribute("width", mOptions.mWidth);
+  mapElem->SetAttribute("height", mOptions.mHeight);
+  mapElem->SetAttribute("tilewidth", TILE_SIZE);
+  mapElem->SetAttribute("tileheight", TILE_SIZE);
+  mapElem->SetAttribute("infinite", 0);
+
+  NOT_NULL(doc.LinkEndChild(mapElem));
+
+  TiXmlElement *const tilesetElem{new (std::nothrow) TiXmlElement{"tileset"}};
+
+  NOT_NULL(tilesetElem);
+
+  tilesetElem->SetAttribute("firstgid", 1);
+  tilesetElem->SetAttribute("name", "Tiles");
+  tilesetElem->SetAttribute("tilewidth", TILE_SIZE);
+  tilesetElem->SetAttribute("tileheight", TILE_SIZE);
+  tilesetElem->SetAttribute("tilecount", MAX_GID);
+  tilesetElem->SetAttribute("columns", TILESET_TEXTURE_SIZE / TILE_SIZE);
+
+  NOT_NULL(mapElem->LinkEndChild(tilesetElem));
+
+  TiXmlElement *const imageElem{new (std::nothrow) TiXmlElement{"image"}};
+
+  NOT_NULL(imageElem);
+
+  imageElem->SetAttribute("source", TILESET_SOURCE);
+  imageElem->SetAttribute("width", TILESET_TEXTURE_SIZE);
+  imageElem->SetAttribute("height", TILESET_TEXTURE_SIZE);
+
+  NOT_NULL(tilesetElem->LinkEndChild(imageElem));
+
+  TiXmlElement *const layerElem{new (std::nothrow) TiXmlElement{"layer"}};
+
+  NOT_NULL(layerElem);
+
+  layerElem->SetAttribute("id", 1);
+  layerElem->SetAttribute("name", "Tile Layer 1");
+  layerElem->SetAttribute("width", mOptions.mWidth);
+  layerElem->SetAttribute("height", mOptions.mHeight);
+
+  NOT_NULL(mapElem->LinkEndChild(layerElem));
+
+  TiXmlElement *const dataElem{new (std::nothrow) TiXmlElement{"data"}};
+
+  NOT_NULL(dataElem);
+
+  dataElem->SetAttribute("encoding", "csv");
+
+  std::ostringstream gidStream;
+
+  for (size_t i = 0; i < mGids.size(); i++) {
+    gidStream << (i == 0 ? "" : ",") << mGids[i];
+  }
+
+  TiXmlText *const gidText{new (std::nothrow) TiXmlText{gidStream.str()}};
+
+  NOT_NULL(gidText);
+  NOT_NULL(dataElem->LinkEndChild(gidText));
+  NOT_NULL(layerElem->LinkEndChild(dataElem));
+
+  TiXmlElement *const objectgroupElem{new (std::nothrow)
+                                          TiXmlElement{"objectgroup"}};
+
+  NOT_NULL(objectgroupElem);
+
+  objectgroupElem->SetAttribute("id", 2);
+  objectgroupElem->SetAttribute("name", "Object Layer 1");
+
+  NOT_NULL(mapElem->LinkEndChild(objectgroupElem));
+
+  int id = 1;
+
+  for (const auto &object : mObjects) {
+    TiXmlElement *const objectElem{new (std::nothrow) TiXmlElement{"object"}};
+
+    NOT_NULL(objectElem);
+
+    objectElem->SetAttribute("id", id++);
+    objectElem->SetAttribute("name", object.mName);
+    objectElem->SetDoubleAttribute("x", object.mX);
+    objectElem->SetDoubleAttribute("y", object.mY);
+    objectElem->SetDoubleAttribute("width", object.mWidth);
+    objectElem->SetDoubleAttribute("height", object.mHeight);
+
+    NOT_NULL(objectgroupElem->LinkEndChild(objectElem));
+  }
+
+  CHECK(doc.SaveFile(mOptions.mOutputFile));
+
+  LOG("level saved to %s", mOptions.mOutputFile.c_str());
+}
+
+// floors are horizontal solid rows, the last one is the bottom of the map
+unsigned int LevelGenerator::getFloorCount() const {
+  return (mOptions.mHeight - 1u) / FLOOR_SPACING;
+}
+
+float LevelGenerator::getFloorTop(unsigned int floor) const {
+  return static_cast<float>((mOptions.mHeight - 1u -
+                             (getFloorCount() - 1u - floor) * FLOOR_SPACING) *
+                            TILE_SIZE);
+}
+
+void LevelGenerator::generateTiles() {
+  const auto width = mOptions.mWidth;
+  const auto height = mOptions.mHeight;
+
+  std::bernoulli_distribution decoration(mOptions.mTileDensity);
+  std::uniform_int_distribution<unsigned int> gid(1u, MAX_GID);
+
+  mGids.assign(width * height, 0u);
+
+  for (unsigned int y = 0; y < height; y++) {
+    for (unsigned int x = 0; x < width; x++) {
+      auto &tile = mGids[y * width + x];
+
+      if (x == 0 || y == 0 || x == width - 1 || y == height - 1) {
+        tile = WALL_GID;
+      } else if (decoration(mRandom)) {
+        tile = gid(mRandom);
+      }
+    }
+  }
+
+  for (unsigned int floor = 0; floor < getFloorCount(); floor++) {
+    const auto y = static_cast<unsigned int>(getFloorTop(floor)) / TILE_SIZE;
+
+    for (unsigned int x = 1; x < width - 1; x++) {
+      mGids[y * width + x] = FLOOR_GID;
+    }
+  }
+}
+
+void LevelGenerator::generateGeometry() {
+  const auto tile = static_cast<float>(TILE_SIZE);
+  const auto width = static_cast<float>(mOptions.mWidth) * tile;
+  const auto height = static_cast<float>(mOptions.mHeight) * tile;
+
+  // walls and ceiling, the bottom floor closes the map
+  mObjects.push_back({"solid", 0.f, 0.f, tile, height});
+  mObjects.push_back({"solid", width - tile, 0.f, tile, height});
+  mObjects.push_back({"solid", tile, 0.f, width - 2.f * tile, tile});
+
+  // floors are split into segments to get a realistic amount of bodies
+  const auto segmentWidth = static_cast<float>(FLOOR_SEGMENT_TILES) * tile;
+
+  for (unsigned int floor = 0; floor < getFloorCount(); floor++) {
+    for (float x = tile; x < width - tile; x += segmentWidth) {
+      mObjects.push_back({"solid", x, getFloorTop(floor),
+                          std::min(segmentWidth, width - tile - x), tile});
+    }
+  }
+}
+
+void LevelGenerator::placeOnFloors(const ObjectSize &size,
+                                   unsigned int count) {
+  for (unsigned int i = 0; i < count; i++) {
+    const auto floor = randomFloor();
+
+    mObjects.push_back({size.mName, randomX(size.mWidth),
+                        getFloorTop(floor) - size.mHeight, size.mWidth,
+                        size.mHeight});
+  }
+}
+
+void LevelGenerator::placeBetweenFloors(const ObjectSize &size,
+                                        unsigned int count) {
+  const auto spacing = static_cast<float>(FLOOR_SPACING * TILE_SIZE);
+
+  for (unsigned int i = 0; i < count; i++) {
+    const auto floor = randomFloor();
+
+    mObjects.push_back({size.mName, randomX(size.mWidth),
+                        getFloorTop(floor) - spacing / 2.f, size.mWidth,
+                        size.mHeight});
+  }
+}
+
+float LevelGenerator::randomX(float width) {
+  const auto tile = static_cast<float>(TILE_SIZE);
+  const auto mapWidth = static_cast<float>(mOptions.mWidth) * tile;
+
+  // keep the player spawn free
+  std::uniform_real_distribution<float> x(4.f * tile,
+                                          mapWidth - tile - width);
+
+  return std::floor(x(mRandom));
+}
+
+unsigned int LevelGenerator::randomFloor() {
+  std::uniform_int_distribution<unsigned int> floor(0u, getFloorCount() - 1u);
+
+  return floor(mRandom);
+}
+
+unsigned int toUint(const char *const str) {
+  NOT_NULL(str);
+
+  const std::string copy = str;
+  size_t pos = 0;
+  const auto value = std::stoul(copy, &pos);
+
+  CHECK(pos == copy.size());
+
+  return static_cast<unsigned int>(value);
+}
+
+const char *nextArgument(int argc, char **argv, int &index) {
+  CHECK(index + 1 < argc);
+
+  return argv[++index];
+}
+} // unnamed namespace
+
+int main(int argc, char **argv) {
+  GeneratorOptions options;
+
+  const CountOption countOptions[] = {
+      {"--width", &GeneratorOptions::mWidth},
+      {"--height", &GeneratorOptions::mHeight},
+      {"--seed", &GeneratorOptions::mSeed},
+      {"--enemies", &GeneratorOptions::mEnemies},
+      {"--archers", &GeneratorOptions::mArchers},
+      {"--horizontal-platforms", &GeneratorOptions::mHorizontalPlatforms},
+      {"--vertical-platforms", &GeneratorOptions::mVerticalPlatforms},
+      {"--ladders", &GeneratorOptions::mLadders},
+      {"--slopes", &GeneratorOptions::mSlopes},
+      {"--hazards", &GeneratorOptions::mHazards},
+  };
+
+  for (int i = 1; i < argc; i++) {
+    const std::string argument = argv[i];
+
+    const auto it =
+        std::find_if(std::begin(countOptions), std::end(countOptions),
+                     [&argument](const CountOption &option) {
+                       return option.first == argument;
+                     });
+
+    if (it != std::end(countOptions)) {
+      options.*(it->second) = toUint(nextArgument(argc, argv, i));
+    } else if (argument == "--tile-density") {
+      options.mTileDensity = std::stof(nextArgument(argc, argv, i));
+    } else if (argument == "--output") {
+      options.mOutputFile = nextArgument(argc, argv, i);
+    } else {
+      LOG("unknown argument: %s", argument.c_str());
+      CHECK(false);
+    }
+  }
+
+  LevelGenerator generator{options};
+  generator.generate();
+  generator.save();
+
+  return 0;
+}